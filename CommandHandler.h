@@ -15,7 +15,22 @@
 #include <iomanip>
 #include <memory> 
 #include "core/GraphStore.h"
+#include "analytics/CliqueScanner.h"
+#include "analytics/TemporalPaths.h"
+#include "analytics/TemporalReachability.h"
+#include "analytics/Centrality.h"
+#include "analytics/Betweenness.h"
+#include "analytics/CommonNeighbors.h"
+#include "analytics/LinkPrediction.h"
+#include "persistence/BinarySnapshot.h"
+#include "persistence/TextSnapshot.h"
+#include "persistence/Journal.h"
+#include "persistence/JsonWriter.h"
+#include "persistence/GraphSerializer.h"
+#include "concurrency/IngestFeed.h"
+#include <chrono>
 #include <ctime>
+#include <climits>
 using namespace std;
 using namespace graph;
 
@@ -30,141 +45,153 @@ public:
         return string(buf);
     }
     static void listNodes(GraphStore* store) {
-        auto& nodes = store->getNodes();
-        if (nodes.empty()) { cout << "�� Graph is empty (0 nodes)." << endl; return; }
+        if (store->nodeCount() == 0) { cout << "�� Graph is empty (0 nodes)." << endl; return; }
         cout << "�� --- NODE REGISTRY ---" << endl;
-        for (auto const& [id, n] : nodes) {
-            cout << "  [ID: " << id << "] " << n->label() << " (Img: " << n->image() << ")" << endl;
-        }
+        store->forEachNode([](const Node& n) {
+            cout << "  [ID: " << n.id() << "] " << n.label() << " (Img: " << n.image() << ")" << endl;
+        });
     }
 
     static void findNode(GraphStore* store, string query) {
         bool found = false;
-        for (auto const& [id, n] : store->getNodes()) {
-            if (n->label().find(query) != string::npos) {
-                cout << "�� Found: [ID " << id << "] " << n->label() << endl;
+        store->forEachNode([&](const Node& n) {
+            if (n.label().find(query) != string::npos) {
+                cout << "�� Found: [ID " << n.id() << "] " << n.label() << endl;
                 found = true;
             }
-        }
+        });
         if (!found) cout << "❌ No node found matching '" << query << "'" << endl;
     }
 
     static void renameNode(GraphStore* store, uint64_t id, string newName) {
-        if (store->getNodes().count(id)) {
-            // FIX: Used make_unique instead of make_shared
-            string oldImg = store->getNodes()[id]->image(); // Keep the old image
-            store->getNodes()[id] = make_unique<Node>(id, newName); 
-            store->getNodes()[id]->setImage(oldImg); // Restore image
-            cout << "✏️ Renamed node " << id << " -> " << newName << endl;
-        } else cout << "❌ ID not found." << endl;
+        if (store->renameNode(id, newName)) cout << "✏️ Renamed node " << id << " -> " << newName << endl;
+        else cout << "❌ ID not found." << endl;
     }
 
     // --- [ANALYZE] ---
     static void showStats(GraphStore* store) {
-        int edges = 0;
-        for(auto const& [t, l] : store->getChronologicalEdges()) edges += l.size();
-        cout << "�� STATISTICS:\n  - Nodes: " << store->getNodes().size() << "\n  - Edges: " << edges << endl;
+        size_t edges = store->edgeCount();
+        cout << "�� STATISTICS:\n  - Nodes: " << store->nodeCount() << "\n  - Edges: " << edges << endl;
     }
 
-    static void showRank(GraphStore* store) {
+    static void showRank(GraphStore* store, size_t k = SIZE_MAX,
+                         DegreeIndex::Metric metric = DegreeIndex::Metric::Total) {
+        // Degrees are maintained on ingest; this is a walk off the top of an ordered index.
+        auto top = store->topByDegree(metric, k);
         vector<pair<int, string>> ranks;
-        for (auto const& [id, n] : store->getNodes()) {
-            int deg = 0;
-            for (auto const& [ts, list] : store->getChronologicalEdges())
-                for (auto const& e : list) if (e->source() == id || e->target() == id) deg++;
-            ranks.push_back({deg, n->label()});
-        }
+        for (auto const& [id, deg] : top) ranks.push_back({(int)deg, store->getNodeLabel(id)});
         sort(ranks.rbegin(), ranks.rend());
         cout << "�� --- INFLUENCE RANKING ---" << endl;
         for (auto const& r : ranks) cout << "  #" << r.first << " Links: " << r.second << endl;
     }
 
-static void runRedFlag(GraphStore* store) {
-    cout << "�� --- CONSPIRACY SCANNER (Optimized) ---" << endl;
-    
-    // 1. Pre-calculate Adjacency List for O(1) lookups
-    unordered_map<uint64_t, set<uint64_t>> adj;
-    for (auto const& [ts, list] : store->getChronologicalEdges()) {
-        for (auto const& e : list) {
-            adj[e->source()].insert(e->target());
-            adj[e->target()].insert(e->source());
+    enum class CentralityKind { PageRank, Personalized, Eigenvector };
+
+    // Power-iteration centrality over the frozen graph. `seed` is only used for
+    // personalized PageRank; halfLife > 0 down-weights old interactions.
+    static void showCentrality(GraphStore* store, size_t k, CentralityKind kind,
+                               uint64_t seed = 0, long long halfLife = 0, unsigned threads = 0) {
+        auto g = store->freeze();
+        CentralityOptions opt;
+        opt.halfLife = halfLife;
+        opt.threads = threads;
+
+        CentralityResult res;
+        string title;
+        switch (kind) {
+            case CentralityKind::Personalized:
+                if (g->indexOf(seed) == CsrSnapshot::npos) { cout << "❌ ID not found." << endl; return; }
+                res = Centrality::personalizedPageRank(*g, {seed}, opt);
+                title = "Personalized PageRank from " + store->getNodeLabel(seed);
+                break;
+            case CentralityKind::Eigenvector:
+                res = Centrality::eigenvector(*g, opt);
+                title = "Eigenvector";
+                break;
+            default:
+                res = Centrality::pageRank(*g, opt);
+                title = "PageRank";
         }
-    }
 
-    bool found = false;
-    // 2. Iterate through nodes and their neighbors
-    for (auto const& [u, neighbors] : adj) {
-        for (uint64_t v : neighbors) {
-            if (v <= u) continue; // Avoid duplicate pairs
-            
-            for (uint64_t w : neighbors) {
-                if (w <= v) continue; // Ensure u < v < w order
-                
-                // 3. Check if v and w are also connected
-                if (adj[v].count(w)) {
-                    cout << "⚠️ TRIANGLE DETECTED: " 
-                         << store->getNodeLabel(u) << " <-> " 
-                         << store->getNodeLabel(v) << " <-> " 
-                         << store->getNodeLabel(w) << endl;
-                    found = true;
-                }
-            }
-        }
+        cout << "�� --- INFLUENCE RANKING (" << title << (halfLife > 0 ? ", time-decayed" : "") << ") ---" << endl;
+        size_t pos = 0;
+        for (auto const& [v, score] : res.top(k))
+            cout << "  #" << ++pos << " " << store->getNodeLabel(g->idOf(v)) << " (" << fixed << setprecision(6) << score << ")" << endl;
+        cout << defaultfloat << "  " << (res.converged ? "Converged" : "Stopped") << " after " << res.iterations << " iterations." << endl;
     }
-    if (!found) cout << "✅ No suspicious triangles found." << endl;
-}
-    // --- [NAVIGATE] ---
-struct TemporalState {
-    uint64_t node;
-    long long lastTs;
-    vector<uint64_t> path;
-};
-static void findPath(GraphStore* store, uint64_t start, uint64_t end) {
-    queue<TemporalState> q;
-    q.push({start, LLONG_MIN, {start}});
 
-    set<pair<uint64_t, long long>> visited;
+static void runRedFlag(GraphStore* store, unsigned k = 3, bool countOnly = false, unsigned threads = 1) {
+    cout << "�� --- CONSPIRACY SCANNER (Optimized) ---" << endl;
+    if (k < 3) { cout << "❌ Clique size must be at least 3." << endl; return; }
 
-    while (!q.empty()) {
-        auto cur = q.front(); q.pop();
+    // Degree-ordered clique enumeration over the shared CSR snapshot
+    auto g = store->freeze();
+    CliqueScanner scanner(*g);
+    string kind = (k == 3) ? "TRIANGLE" : to_string(k) + "-CLIQUE";
 
-        if (cur.node == end) {
-            cout << "�� TIME-VALID PATH FOUND:\n  ";
-            for (size_t i = 0; i < cur.path.size(); ++i)
-                cout << store->getNodeLabel(cur.path[i])
-                     << (i + 1 < cur.path.size() ? " → " : "");
-            cout << endl;
-            return;
-        }
+    if (countOnly) {
+        cout << "�� " << kind << " COUNT: " << scanner.countCliques(k, threads) << endl;
+        return;
+    }
 
-        for (auto const& [ts, list] : store->getChronologicalEdges()) {
-            if (ts < cur.lastTs) continue; // ⛔ NO TIME TRAVEL
-
-            for (auto const& e : list) {
-                uint64_t next = 0;
-                if (e->source() == cur.node) next = e->target();
-                else if (e->target() == cur.node) next = e->source();
-                else continue;
-
-                if (!visited.count({next, ts})) {
-                    visited.insert({next, ts});
-                    auto newPath = cur.path;
-                    newPath.push_back(next);
-                    q.push({next, ts, newPath});
-                }
-            }
-        }
+    auto cliques = scanner.listCliques(k, threads);
+    for (auto const& c : cliques) {
+        cout << "⚠️ " << kind << " DETECTED: ";
+        for (size_t i = 0; i < c.size(); ++i)
+            cout << store->getNodeLabel(c[i]) << (i + 1 < c.size() ? " <-> " : "");
+        cout << endl;
+    }
+    if (cliques.empty()) cout << "✅ No suspicious " << (k == 3 ? "triangles" : "cliques") << " found." << endl;
+}
+    // --- [NAVIGATE] ---
+static void findPath(GraphStore* store, uint64_t start, uint64_t end,
+                     TemporalPaths::Mode mode = TemporalPaths::Mode::FewestHops) {
+    // One chronological sweep over the frozen edge stream; ⛔ NO TIME TRAVEL
+    auto g = store->freeze();
+    Journey j = TemporalPaths(*g).find(mode, start, end);
+
+    if (!j.found()) {
+        cout << "❌ No chronologically valid path found." << endl;
+        return;
     }
+    cout << "�� TIME-VALID PATH FOUND:\n  ";
+    for (size_t i = 0; i < j.nodes.size(); ++i)
+        cout << store->getNodeLabel(j.nodes[i])
+             << (i + 1 < j.nodes.size() ? " → " : "");
+    cout << endl;
+    if (j.hops() > 0)
+        cout << "  Departs " << formatTime(j.departure()) << ", arrives " << formatTime(j.arrival())
+             << " (" << j.hops() << " hops)" << endl;
+}
 
-    cout << "❌ No chronologically valid path found." << endl;
+// Who could have received information from `source` leaving at `from`? With no
+// targets given, every node is checked. One chronological pass answers the batch.
+static void showReachability(GraphStore* store, uint64_t source, long long from, vector<uint64_t> targets) {
+    auto g = store->freeze();
+    if (g->indexOf(source) == CsrSnapshot::npos) { cout << "❌ ID not found." << endl; return; }
+    if (targets.empty())
+        for (uint32_t v = 0; v < g->nodeCount(); ++v)
+            if (g->idOf(v) != source) targets.push_back(g->idOf(v));
+
+    auto arrivals = TemporalReachability(*g).oneToMany(source, targets, from);
+    cout << "�� --- REACHABILITY FROM " << store->getNodeLabel(source) << " AFTER " << formatTime(from) << " ---" << endl;
+    size_t reached = 0;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (arrivals[i] == TemporalReachability::kUnreachable) {
+            cout << "  ✖ " << store->getNodeLabel(targets[i]) << " : unreachable" << endl;
+        } else {
+            cout << "  ✔ " << store->getNodeLabel(targets[i]) << " : earliest " << formatTime(arrivals[i]) << endl;
+            ++reached;
+        }
+    }
+    cout << "  " << reached << "/" << targets.size() << " reachable." << endl;
 }
 
-static long long findSmallestGap(vector<long long>& timesA, vector<long long>& timesB) {
+// Both lists must be sorted ascending (pair histories from the store and the
+// witness engine already are), so no re-sorting here.
+static long long findSmallestGap(const vector<long long>& timesA, const vector<long long>& timesB) {
     if (timesA.empty() || timesB.empty()) return LONG_MAX;
 
-    sort(timesA.begin(), timesA.end());
-    sort(timesB.begin(), timesB.end());
-
     long long minGap = LONG_MAX;
     size_t i = 0, j = 0;
 
@@ -196,19 +223,18 @@ static InvestigationReport analyzeRelationship(GraphStore* store, uint64_t a, ui
     report.globalConfidence = 0.0;
 
     // Fix 3: Get all witnesses instead of overwriting
-    vector<uint64_t> witnesses = store->getCommonNeighbors(a, b);
+    // (intersection and pair histories read from the store in one locked pass)
+    vector<Witness> witnesses = CommonNeighbors::witnesses(*store, a, b);
 
-    for (uint64_t w : witnesses) {
+    for (Witness& w : witnesses) {
         Finding f;
-        f.witnessName = store->getNodeLabel(w);
+        f.witnessName = store->getNodeLabel(w.id);
 
         // Fix 1: Find the absolute minimum temporal gap (Temporal Minimization)
-        auto timesA = store->getAllTimestamps(a, w);
-        auto timesB = store->getAllTimestamps(b, w);
-        f.minGapSeconds = findSmallestGap(timesA, timesB); 
+        f.minGapSeconds = findSmallestGap(w.timesA, w.timesB); 
 
         // Fix 4: Explain the "Low Traffic" logic in the narrative
-        int activity = store->getDegree(w);
+        int activity = (int)w.degree;
         bool isPrivateLink = (activity < 10);
         
         f.narrative = f.witnessName + " acted as a bridge within " + to_string(f.minGapSeconds / 3600) + "h. ";
@@ -234,13 +260,12 @@ static InvestigationReport analyzeRelationship(GraphStore* store, uint64_t a, ui
     return report;
 }
 static void runDossier(GraphStore* store, uint64_t id) {
-        auto& nodes = store->getNodes();
-        if (!nodes.count(id)) {
+        auto node = store->getNode(id);
+        if (!node) {
             cout << "❌ Error: Node ID " << id << " not found." << endl;
             return;
         }
 
-        auto& node = nodes.at(id);
         cout << "\n�� --- DOSSIER: " << node->label() << " ---" << endl;
         cout << "  [ID]        : " << id << endl;
         cout << "  [IMAGE]     : " << (node->image().empty() ? "None" : node->image()) << endl;
@@ -249,18 +274,14 @@ static void runDossier(GraphStore* store, uint64_t id) {
         long long firstSeen = -1, lastSeen = -1;
         vector<string> neighbors;
 
-        for (auto const& [ts, list] : store->getChronologicalEdges()) {
-            for (auto const& e : list) {
-                uint64_t target = 0;
-                if (e->source() == id) target = e->target();
-                else if (e->target() == id) target = e->source();
-                else continue;
-
-                connections++;
-                neighbors.push_back(store->getNodeLabel(target));
-                if (firstSeen == -1 || ts < firstSeen) firstSeen = ts;
-                if (ts > lastSeen) lastSeen = ts;
-            }
+        for (auto const& e : store->getIncidentEdges(id)) {
+            uint64_t target = (e.source() == id) ? e.target() : e.source();
+            long long ts = e.timestamp();
+
+            connections++;
+            neighbors.push_back(store->getNodeLabel(target));
+            if (firstSeen == -1 || ts < firstSeen) firstSeen = ts;
+            if (ts > lastSeen) lastSeen = ts;
         }
 
         cout << "  [CONNECTIONS]: " << connections << endl;
@@ -278,56 +299,35 @@ static void runDossier(GraphStore* store, uint64_t id) {
     static void showNeighbors(GraphStore* store, uint64_t id) {
         cout << "��️ NEIGHBORS of " << store->getNodeLabel(id) << ":" << endl;
         bool found = false;
-        for(auto const& [ts, list] : store->getChronologicalEdges()) {
-            for(auto const& e : list) {
-                if(e->source() == id) { cout << "  -> " << store->getNodeLabel(e->target()) << endl; found = true; }
-                if(e->target() == id) { cout << "  -> " << store->getNodeLabel(e->source()) << endl; found = true; }
-            }
+        for(auto const& e : store->getIncidentEdges(id)) {
+            uint64_t other = (e.source() == id) ? e.target() : e.source();
+            cout << "  -> " << store->getNodeLabel(other) << endl;
+            found = true;
         }
         if (!found) cout << "  (Isolated Node)" << endl;
     }
 
 static void calculatePossibility(GraphStore* store, uint64_t u, uint64_t v) {
-    auto& nodes = store->getNodes();
-
     // 1. Validation: Ensure both nodes exist
-    if (!nodes.count(u) || !nodes.count(v)) {
+    if (!store->hasNode(u) || !store->hasNode(v)) {
         cout << "❌ Error: One or both Node IDs do not exist." << endl;
         return;
     }
 
-    // 2. Map the "Neighborhood" for both nodes
-    set<uint64_t> neighborsU, neighborsV;
-    for (auto const& [ts, list] : store->getChronologicalEdges()) {
-        for (auto const& e : list) {
-            if (e->source() == u) neighborsU.insert(e->target());
-            else if (e->target() == u) neighborsU.insert(e->source());
-
-            if (e->source() == v) neighborsV.insert(e->target());
-            else if (e->target() == v) neighborsV.insert(e->source());
-        }
-    }
-
-    // 3. Calculate Intersection (Shared Neighbors)
-    set<uint64_t> shared;
-    for (uint64_t n : neighborsU) {
-        if (neighborsV.count(n)) shared.insert(n);
-    }
-
-    // 4. Calculate Union (Total Unique Neighbors)
-    set<uint64_t> totalUnique = neighborsU;
-    totalUnique.insert(neighborsV.begin(), neighborsV.end());
+    // 2-4. Shared and total unique neighbors from the store's incidence index
+    auto overlap = CommonNeighbors::overlap(*store, u, v);
+    size_t unionSize = overlap.combined;
 
     // 5. Calculate & Display Results
     cout << "�� --- POSSIBILITY ANALYSIS ---" << endl;
     cout << "  Target A: " << store->getNodeLabel(u) << endl;
     cout << "  Target B: " << store->getNodeLabel(v) << endl;
 
-    if (totalUnique.empty()) {
+    if (unionSize == 0) {
         cout << "  Strength: 0% (Isolated nodes)" << endl;
     } else {
-        double score = (double)shared.size() / totalUnique.size();
-        cout << "  Shared Partners: " << shared.size() << endl;
+        double score = (double)overlap.shared / unionSize;
+        cout << "  Shared Partners: " << overlap.shared << endl;
         cout << "  Network Overlap: " << (score * 100) << "%" << endl;
 
         if (score > 0.6) cout << "  ⚠️  STATUS: Extremely High Probability of direct collaboration." << endl;
@@ -335,141 +335,114 @@ static void calculatePossibility(GraphStore* store, uint64_t u, uint64_t v) {
         else cout << "  �� STATUS: Weak/No correlation." << endl;
     }
 }
+    // Screens every not-directly-linked pair that shares a contact, in one batch job.
+    static void showSimilarPairs(GraphStore* store, size_t k,
+                                 LinkPredictionOptions::Metric metric = LinkPredictionOptions::Metric::AdamicAdar,
+                                 unsigned threads = 0) {
+        auto g = store->freeze();
+        LinkPredictionOptions opt;
+        opt.rankBy = metric;
+        opt.threads = threads;
+        auto pairs = LinkPrediction::topPairs(*g, k, opt);
+
+        const char* name = metric == LinkPredictionOptions::Metric::Jaccard ? "Jaccard"
+                         : metric == LinkPredictionOptions::Metric::ResourceAllocation ? "Resource Allocation" : "Adamic-Adar";
+        cout << "�� --- HIDDEN COLLABORATION SCREEN (" << name << ") ---" << endl;
+        if (pairs.empty()) { cout << "  No unlinked pairs share a contact." << endl; return; }
+        cout << fixed << setprecision(3);
+        for (auto const& p : pairs)
+            cout << "  " << store->getNodeLabel(p.a) << " <?> " << store->getNodeLabel(p.b)
+                 << " | shared " << p.common << " | Jaccard " << p.jaccard
+                 << " | AA " << p.adamicAdar << " | RA " << p.resourceAllocation << endl;
+        cout << defaultfloat;
+    }
+
     static void findWitness(GraphStore* store, uint64_t u, uint64_t v) {
-        set<uint64_t> un, vn;
-        for(auto const& [ts, l] : store->getChronologicalEdges()) 
-            for(auto const& e : l) {
-                if(e->source()==u) un.insert(e->target()); if(e->target()==u) un.insert(e->source());
-                if(e->source()==v) vn.insert(e->target()); if(e->target()==v) vn.insert(e->source());
-            }
         cout << "��️ SEARCHING FOR COMMON LINKS..." << endl;
         bool found = false;
-        for(auto n : un) if(vn.count(n)) { cout << "  ⚠️ WITNESS: " << store->getNodeLabel(n) << endl; found = true; }
+        for(auto n : CommonNeighbors::shared(*store, u, v)) { cout << "  ⚠️ WITNESS: " << store->getNodeLabel(n) << endl; found = true; }
         if(!found) cout << "  No common witness found." << endl;
     }
 
     // --- [SECURITY] ---
-    static void showBottlenecks(GraphStore* store) {
-        cout << "�� --- BOTTLENECK ANALYSIS ---" << endl;
-        for(auto const& [id, n] : store->getNodes()) {
-            int deg=0; 
-            for(auto const& [ts, l] : store->getChronologicalEdges()) 
-                for(auto const& e : l) if(e->source()==id||e->target()==id) deg++;
-            if(deg > 3) cout << "  �� HIGH TRAFFIC: " << n->label() << " (" << deg << " connections)" << endl;
+    // Brokers = highest betweenness: nodes that sit on the most shortest paths.
+    // epsilon > 0 samples BFS sources for a +/- epsilon bound; 0 is exact.
+    static void showBottlenecks(GraphStore* store, size_t k = 10, double epsilon = 0.01, unsigned threads = 0) {
+        auto g = store->freeze();
+        BetweennessOptions opt;
+        opt.epsilon = epsilon;
+        opt.threads = threads;
+        auto res = Betweenness::compute(*g, opt);
+
+        cout << "�� --- BOTTLENECK ANALYSIS (Betweenness, ";
+        if (res.exact) cout << "exact";
+        else cout << "sampled " << res.sources << " sources, ±" << epsilon;
+        cout << ") ---" << endl;
+        bool found = false;
+        for (auto const& [v, score] : res.top(k)) {
+            if (score <= 0) break;
+            cout << "  �� BROKER: " << store->getNodeLabel(g->idOf(v)) << " (" << fixed << setprecision(4) << score << ")" << defaultfloat << endl;
+            found = true;
         }
+        if (!found) cout << "  No brokers: no node lies between any others." << endl;
     }
 
     // --- [HISTORY & FILE I/O] ---
-static void showTimeline(GraphStore* store) {
-        auto timeline = store->getChronologicalEdges();
-        if(timeline.empty()) { cout << "⏳ No events in timeline." << endl; return; }
-        cout << "�� --- HUMAN-READABLE TIMELINE ---" << endl;
-        for (auto const& [ts, list] : timeline) {
-            string timeStr = formatTime(ts);
-            for (auto const& e : list)
-                cout << "  [" << timeStr << "] " << store->getNodeLabel(e->source()) << " <---> " << store->getNodeLabel(e->target()) << endl;
-        }
+static void showTimeline(GraphStore* store, long long from = LLONG_MIN, long long to = LLONG_MAX) {
+        // Walked from a pinned version so no store lock is held while printing.
+        GraphView view = store->pin();
+        bool any = false;
+        view.forEachEdgeInRange(from, to, [&](uint64_t src, uint64_t tgt, long long ts) {
+            if (!any) cout << "�� --- HUMAN-READABLE TIMELINE ---" << endl;
+            any = true;
+            cout << "  [" << formatTime(ts) << "] " << store->getNodeLabel(src) << " <---> " << store->getNodeLabel(tgt) << endl;
+        });
+        if (!any) cout << "⏳ No events in timeline." << endl;
+    }
+    // One page of the timeline, read straight from the store. Prints the token to
+    // continue from so large cases can be walked a page at a time.
+    static void showTimelinePage(GraphStore* store, const TimelineCursor& from, size_t limit = 50) {
+        cout << "�� --- TIMELINE PAGE ---" << endl;
+        // The page is copied out under the store's lock and printed after it is released.
+        vector<Edge> page;
+        TimelineCursor next = store->forEachEdgeFrom(from, limit, [&](const Edge& e) { page.push_back(e); });
+        for (const Edge& e : page)
+            cout << "  [" << formatTime(e.timestamp()) << "] " << store->getNodeLabel(e.source()) << " <---> " << store->getNodeLabel(e.target()) << endl;
+        if (page.empty()) cout << "⏳ No events in timeline." << endl;
+        if (next.end) cout << "  -- end of timeline --" << endl;
+        else cout << "  ▶️ More: timeline page " << next.token() << " " << limit << endl;
     }
 static void runForensics(GraphStore* store, long long s, long long e) {
         cout << "�� FORENSIC WINDOW: " << formatTime(s) << " to " << formatTime(e) << endl;
-        for (auto const& [ts, list] : store->getChronologicalEdges()) {
-            if(ts >= s && ts <= e) {
-                for(auto const& ed : list) 
-                    cout << "  MATCH: [" << formatTime(ts) << "] " << store->getNodeLabel(ed->source()) << " <-> " << store->getNodeLabel(ed->target()) << endl;
-            }
-        }
+        GraphView view = store->pin();
+        view.forEachEdgeInRange(s, e, [&](uint64_t src, uint64_t tgt, long long ts) {
+            cout << "  MATCH: [" << formatTime(ts) << "] " << store->getNodeLabel(src) << " <-> " << store->getNodeLabel(tgt) << endl;
+        });
     }
-static void loadSnapshot(GraphStore* store) {
+static void loadSnapshot(GraphStore* store, unsigned threads = 0) {
         const std::string filename = "graph_snapshot.txt";
-        std::ifstream in(filename);
-        if (!in.is_open()) {
-            std::cout << "❌ File not found: " << filename << std::endl;
+        auto res = TextSnapshot::load(*store, filename, threads);
+        if (!res.ok) {
+            std::cout << "❌ " << res.error << std::endl;
             return;
         }
-
-        auto parseToken = [&](const std::string &line, size_t &pos) -> std::string {
-            while (pos < line.size() && std::isspace((unsigned char)line[pos])) ++pos;
-            if (pos >= line.size()) return "";
-            std::string out;
-            if (line[pos] == '"') {
-                ++pos;
-                while (pos < line.size()) {
-                    char c = line[pos++];
-                    if (c == '\\' && pos < line.size()) out.push_back(line[pos++]);
-                    else if (c == '"') break;
-                    else out.push_back(c);
-                }
-            } else {
-                while (pos < line.size() && !std::isspace((unsigned char)line[pos])) out.push_back(line[pos++]);
-            }
-            return out;
-        };
-
-        struct NodeRec { uint64_t fileId; std::string label; std::string img; };
-        struct EdgeRec { uint64_t u; uint64_t v; long long ts; };
-        std::vector<NodeRec> nodeRecs;
-        std::vector<EdgeRec> edgeRecs;
-
-        std::string line;
-        while (std::getline(in, line)) {
-            if (line.empty() || line[0] == '#') continue;
-            size_t pos = 0;
-            std::string typ = parseToken(line, pos);
-            if (typ == "NODE") {
-                uint64_t fid = std::stoull(parseToken(line, pos));
-                std::string lbl = parseToken(line, pos);
-                std::string img = parseToken(line, pos);
-                nodeRecs.push_back({fid, lbl, img});
-            } else if (typ == "EDGE") {
-                uint64_t u = std::stoull(parseToken(line, pos));
-                uint64_t v = std::stoull(parseToken(line, pos));
-                long long ts = std::stoll(parseToken(line, pos));
-                edgeRecs.push_back({u, v, ts});
-            }
-        }
-
-        store->getNodes().clear();
-        store->getChronologicalEdges().clear();
-
-        std::unordered_map<uint64_t, uint64_t> idMap;
-        for (auto &nr : nodeRecs) {
-            uint64_t rid = store->addNode(nr.label);
-            if (!nr.img.empty()) store->getNodes()[rid]->setImage(nr.img);
-            idMap[nr.fileId] = rid;
-        }
-        for (auto &er : edgeRecs) {
-            store->addEdge(idMap[er.u], idMap[er.v], er.ts);
-        }
+        if (res.skipped) std::cout << "⚠️ Skipped " << res.skipped << " malformed line(s)." << std::endl;
         std::cout << "✅ Snapshot loaded successfully." << std::endl;
     }
 // Real Isolation: Removes all edges connected to a specific node
     static void isolateNode(GraphStore* store, uint64_t id) {
-        if (!store->getNodes().count(id)) {
+        if (!store->hasNode(id)) {
             cout << "❌ ID not found." << endl;
             return;
         }
 
-        auto& chronologicalEdges = store->getChronologicalEdges();
-        int removedCount = 0;
-
-        for (auto& [ts, edgeList] : chronologicalEdges) {
-            auto it = edgeList.begin();
-            while (it != edgeList.end()) {
-                if ((*it)->source() == id || (*it)->target() == id) {
-                    it = edgeList.erase(it);
-                    removedCount++;
-                } else {
-                    ++it;
-                }
-            }
-        }
+        size_t removedCount = store->isolateNode(id);
         cout << "��️ ISOLATED: Removed " << removedCount << " active connections for " << store->getNodeLabel(id) << "." << endl;
     }
 
     // Real Purge: Wipes the entire graph from memory
     static void purgeGraph(GraphStore* store) {
-        store->getNodes().clear();
-        store->getChronologicalEdges().clear();
+        store->clear();
         cout << "♻️ Memory Purged. Graph is now empty." << endl;
     }
 static void saveSnapshot(GraphStore* store) {
@@ -480,39 +453,157 @@ static void saveSnapshot(GraphStore* store) {
             return;
         }
 
+        // Nodes and edges from one pinned version, written without holding the store's locks
+        GraphView view = store->pin(true);
+
         // Write Nodes: NODE <id> "<label>" "<image>"
-        for (auto const& [id, n] : store->getNodes()) {
-            out << "NODE " << id << " \"" << n->label() << "\" \"" << n->image() << "\"\n";
-        }
+        const std::vector<uint64_t>& ids = view.nodeIds();
+        for (size_t i = 0; i < ids.size(); ++i)
+            out << "NODE " << ids[i] << " \"" << view.label(i) << "\" \"" << view.image(i) << "\"\n";
 
         // Write Edges: EDGE <u> <v> <timestamp>
-        for (auto const& [ts, list] : store->getChronologicalEdges()) {
-            for (auto const& e : list) {
-                out << "EDGE " << e->source() << " " << e->target() << " " << ts << "\n";
-            }
-        }
+        view.forEachEdge([&](uint64_t src, uint64_t tgt, long long ts) {
+            out << "EDGE " << src << " " << tgt << " " << ts << "\n";
+        });
 
         out.close();
         std::cout << "�� Snapshot saved to " << filename << std::endl;
     }
-static void exportJSON(GraphStore* store) {
-        ofstream out("graph_data.json");
-        out << "{\"nodes\":[";
-        auto& ns = store->getNodes(); size_t i=0;
-        for(auto const& [id, n] : ns) {
-            out << "{\"id\":" << id << ",\"label\":\"" << n->label() << "\",\"image\":\"" << n->image() << "\"}";
-            if(++i < ns.size()) out << ",";
-        }
-        out << "],\"edges\":[";
-        auto tl = store->getChronologicalEdges(); vector<shared_ptr<Edge>> edgs;
-        for(auto const& [ts, l] : tl) for(auto const& e : l) edgs.push_back(e);
-        for(size_t j=0; j<edgs.size(); ++j) {
-            out << "{\"from\":" << edgs[j]->source() << ",\"to\":" << edgs[j]->target() << ",\"ts\":" << edgs[j]->timestamp() << "}";
-            if(j < edgs.size()-1) out << ",";
+    // Binary snapshot: same content as save/load, but mapped and bulk-inserted
+    // instead of parsed line by line.
+    static void saveBinarySnapshot(GraphStore* store, const string& filename = "graph_snapshot.bin") {
+        if (BinarySnapshot::save(*store, filename)) cout << "�� Binary snapshot saved to " << filename << endl;
+        else cout << "❌ Could not write " << filename << endl;
+    }
+    static void loadBinarySnapshot(GraphStore* store, const string& filename = "graph_snapshot.bin") {
+        auto started = chrono::steady_clock::now();
+        string error;
+        auto snap = MappedSnapshot::open(filename, error);
+        if (!snap) { cout << "❌ " << error << endl; return; }
+        BinarySnapshot::load(*store, *snap);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        cout << "✅ Binary snapshot loaded: " << snap->nodeCount() << " nodes, " << snap->edgeCount()
+             << " edges in " << fixed << setprecision(1) << ms << " ms" << defaultfloat << endl;
+    }
+    // Write-ahead journal: from here on every mutation is logged to `dir`, and
+    // the log is compacted into a checkpoint as it grows.
+    // A directory that already holds a journal is refused; recover it instead.
+    static unique_ptr<Journal> startJournal(GraphStore* store, const string& dir, const string& policy = "always",
+                                            const Journal::Recovery* recovered = nullptr) {
+        Journal::Options opt;
+        if (policy == "interval") opt.log.sync = WriteAheadLog::Sync::Interval;
+        else if (policy == "never") opt.log.sync = WriteAheadLog::Sync::Never;
+        else if (policy != "always") { cout << "❌ Unknown fsync policy: " << policy << " (always|interval|never)" << endl; return nullptr; }
+        string error;
+        auto journal = recovered ? Journal::resume(*store, *recovered, opt, error) : Journal::open(*store, dir, opt, error);
+        if (!journal) { cout << "❌ " << error << endl; return nullptr; }
+        cout << "�� Journaling to " << dir << "/ (fsync " << policy << "), checkpoint #" << journal->stats().generation << endl;
+        return journal;
+    }
+    // Crash recovery: newest checkpoint plus the log tail, then journaling resumes in `dir`.
+    static unique_ptr<Journal> recoverJournal(GraphStore* store, const string& dir, const string& policy = "always") {
+        auto res = Journal::recover(*store, dir);
+        if (!res.ok) { cout << "❌ Recovery failed: " << res.error << endl; return nullptr; }
+        cout << fixed << setprecision(1);
+        cout << "�� Recovered from checkpoint #" << res.generation << " (" << res.checkpointNodes << " nodes, "
+             << res.checkpointEdges << " edges) in " << res.checkpointMs << " ms" << endl;
+        cout << "   Replayed " << res.replayed << " log record(s) from " << res.logFiles << " file(s) in " << res.replayMs
+             << " ms; " << res.skipped << " already checkpointed." << defaultfloat << endl;
+        if (res.discardedBytes) cout << "⚠️ Discarded " << res.discardedBytes << " byte(s) of torn log tail." << endl;
+        return startJournal(store, dir, policy, &res);
+    }
+    static void showJournal(const Journal* journal) {
+        if (!journal) { cout << "�� Journal is off. Usage: journal <dir> [always|interval|never]" << endl; return; }
+        auto s = journal->stats();
+        cout << "�� Journal " << journal->directory() << "/: checkpoint #" << s.generation << " at version " << s.checkpointVersion
+             << ", " << s.log.records << " records logged, " << s.log.bytes << " bytes in current log, "
+             << s.log.fsyncs << " fsyncs" << endl;
+        if (s.checkpointFailures) cout << "⚠️ " << s.checkpointFailures << " checkpoint(s) failed." << endl;
+    }
+    static void runCheckpoint(Journal* journal) {
+        if (!journal) { cout << "❌ Journal is off." << endl; return; }
+        string error;
+        if (!journal->checkpoint(error)) { cout << "❌ Checkpoint failed: " << error << endl; return; }
+        auto s = journal->stats();
+        cout << "�� Checkpoint #" << s.generation << " written in " << fixed << setprecision(1) << s.lastCheckpointMs
+             << " ms" << defaultfloat << endl;
+    }
+    // CSV/TSV interchange (tab-separated for .tsv files). Edges are written in
+    // time order; an import adds to the current graph and never merges with it.
+    static void exportCSV(GraphStore* store, const string& edgesFile, const string& nodesFile,
+                          long long from = LLONG_MIN, long long to = LLONG_MAX) {
+        GraphSerializer::Options opt;
+        opt.from = from;
+        opt.to = to;
+        // Both tables from one pinned version; ingest carries on while they are written.
+        GraphView view = store->pin(!nodesFile.empty());
+        if (!GraphSerializer::toCSV(view, edgesFile, opt)) { cout << "❌ Could not write " << edgesFile << endl; return; }
+        if (!nodesFile.empty() && !GraphSerializer::nodesToCSV(view, nodesFile, opt)) { cout << "❌ Could not write " << nodesFile << endl; return; }
+        cout << "�� Edges exported to " << edgesFile;
+        if (!nodesFile.empty()) cout << ", nodes to " << nodesFile;
+        cout << endl;
+    }
+    static void importCSV(GraphStore* store, const string& edgesFile, const string& nodesFile,
+                          long long from = LLONG_MIN, long long to = LLONG_MAX) {
+        auto started = chrono::steady_clock::now();
+        GraphSerializer::Options opt;
+        opt.from = from;
+        opt.to = to;
+        bool merged = store->nodeCount() > 0;
+        auto res = GraphSerializer::fromCSV(*store, edgesFile, nodesFile, opt);
+        if (!res.ok) { cout << "❌ " << res.error << endl; return; }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+        cout << "�� Imported " << res.nodes << " nodes, " << res.edges << " edges in " << fixed << setprecision(1) << ms
+             << " ms" << defaultfloat << endl;
+        if (res.filtered) cout << "   " << res.filtered << " edge(s) outside the time range left out." << endl;
+        if (res.skipped) cout << "⚠️ Skipped " << res.skipped << " malformed row(s)." << endl;
+        if (merged) cout << "   Added alongside the existing graph as new nodes; use clear first to replace it." << endl;
+    }
+    // Live ingest: every file or named pipe added is read by its own collector
+    // thread, and all of them feed one queue whose applier batches into the store.
+    static void startFeed(GraphStore* store, unique_ptr<IngestQueue>& queue, vector<unique_ptr<IngestFeed>>& feeds,
+                          const string& path) {
+        if (!queue) queue = make_unique<IngestQueue>(*store);
+        string error;
+        auto feed = IngestFeed::open(*queue, path, error);
+        if (!feed) { cout << "❌ " << error << endl; return; }
+        feeds.push_back(std::move(feed));
+        cout << "📥 Ingesting from " << path << " (" << feeds.size() << " feed(s) running)" << endl;
+    }
+    static void showIngest(const IngestQueue* queue, const vector<unique_ptr<IngestFeed>>& feeds) {
+        if (!queue) { cout << "📥 Ingest is off. Usage: ingest <file|fifo> | ingest stop" << endl; return; }
+        for (auto const& f : feeds) {
+            auto s = f->stats();
+            cout << "   " << f->path() << ": " << s.pushed << " pushed";
+            if (s.malformed) cout << ", " << s.malformed << " malformed";
+            cout << (s.running ? " (reading)" : " (done)") << endl;
         }
-        out << "]}";
-        out.close();
-        cout << "�� Data exported to graph_data.json" << endl;
+        auto q = queue->stats();
+        cout << "📥 Queue: " << q.applied << "/" << q.enqueued << " applied in " << q.batches << " batches, "
+             << fixed << setprecision(0) << q.recordsPerSec << " rec/s, latency mean " << setprecision(1)
+             << q.meanLatencyUs << " us / max " << q.maxLatencyUs << " us" << defaultfloat << endl;
+    }
+    static void stopIngest(unique_ptr<IngestQueue>& queue, vector<unique_ptr<IngestFeed>>& feeds) {
+        if (!queue) { cout << "📥 Ingest is off." << endl; return; }
+        for (auto& f : feeds) f->stop();
+        queue->stop();
+        auto q = queue->stats();
+        feeds.clear();
+        queue.reset();
+        cout << "📥 Ingest stopped; " << q.applied << " edge(s) applied." << endl;
+    }
+static void exportJSON(GraphStore* store, long long from = LLONG_MIN, long long to = LLONG_MAX, const string& filename = "graph_data.json") {
+        // "-" streams the document to stdout instead of a file.
+        bool toStdout = filename == "-";
+        FILE* f = toStdout ? stdout : fopen(filename.c_str(), "wb");
+        if (!f) { cout << "❌ Could not open " << filename << " for writing." << endl; return; }
+        if (toStdout) cout << flush;
+        JsonWriter out = JsonWriter::toFile(f);
+        bool ok = GraphJson::write(out, *store, from, to);
+        if (toStdout) { fflush(stdout); cout << endl; }
+        else ok = (fclose(f) == 0) && ok;
+        if (!ok) cout << "❌ Write to " << filename << " failed." << endl;
+        else if (!toStdout) cout << "�� Data exported to " << filename << endl;
     }
 };
 
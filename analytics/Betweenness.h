@@ -0,0 +1,130 @@
+#pragma once
+#include "core/CsrSnapshot.h"
+#include "concurrency/WorkStealing.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#include <utility>
+
+namespace graph {
+
+struct BetweennessOptions {
+    unsigned threads = 0;       // 0 = every core
+    // Approximate mode: with probability >= 1 - delta every normalised score is
+    // within +/- epsilon of the exact one. epsilon <= 0 forces the exact algorithm.
+    double epsilon = 0.0;
+    double delta = 0.1;
+    uint64_t seed = 42;         // sampling is reproducible for a given seed
+};
+
+struct BetweennessResult {
+    std::vector<double> score;  // normalised to [0, 1], indexed by dense index
+    size_t sources = 0;         // BFS roots actually processed
+    bool exact = true;
+
+    std::vector<std::pair<uint32_t, double>> top(size_t k) const {
+        std::vector<std::pair<uint32_t, double>> out;
+        for (uint32_t v = 0; v < score.size(); ++v) out.push_back({ v, score[v] });
+        auto cmp = [](auto const& a, auto const& b) { return a.second != b.second ? a.second > b.second : a.first < b.first; };
+        k = std::min(k, out.size());
+        std::partial_sort(out.begin(), out.begin() + k, out.end(), cmp);
+        out.resize(k);
+        return out;
+    }
+};
+
+// Brandes betweenness centrality on the undirected, unweighted distinct-neighbor
+// graph of a CSR snapshot. One BFS plus a reverse dependency sweep per source;
+// predecessors are recovered from BFS depth instead of being stored.
+//
+// Exact mode runs every vertex as a source, spread over the work-stealing loop with
+// per-worker accumulators. Approximate mode runs k = ceil(ln(2n/delta) / (2 eps^2))
+// uniformly sampled sources (Hoeffding plus a union bound over all vertices), which
+// depends on the error bound and only logarithmically on graph size; if k >= n the
+// exact algorithm is cheaper and is used instead.
+class Betweenness {
+public:
+    static BetweennessResult compute(const CsrSnapshot& g, const BetweennessOptions& opt = {}) {
+        const size_t n = g.nodeCount();
+        BetweennessResult res;
+        res.score.assign(n, 0.0);
+        if (n < 3) return res;
+
+        std::vector<uint32_t> roots;
+        if (opt.epsilon > 0) {
+            double k = std::ceil(std::log(2.0 * n / opt.delta) / (2.0 * opt.epsilon * opt.epsilon));
+            if (k < n) {
+                std::mt19937_64 rng(opt.seed);
+                std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(n - 1));
+                roots.resize(static_cast<size_t>(k));
+                for (auto& r : roots) r = pick(rng);
+                res.exact = false;
+            }
+        }
+        if (res.exact) {
+            roots.resize(n);
+            for (uint32_t v = 0; v < n; ++v) roots[v] = v;
+        }
+        res.sources = roots.size();
+
+        unsigned threads = opt.threads ? opt.threads : WorkStealing::defaultThreads();
+        threads = static_cast<unsigned>(std::min<size_t>(threads, roots.size()));
+        std::vector<Worker> workers(threads, Worker(n));
+        WorkStealing::run(roots.size(), threads, 1, [&](size_t b, size_t e, unsigned w) {
+            for (size_t i = b; i < e; ++i) workers[w].accumulate(g, roots[i]);
+        });
+
+        // Each unordered pair is seen from both ends in exact mode; sampling scales
+        // the per-source mean back up to n sources. Then normalise by the pair count.
+        double scale = (res.exact ? 0.5 : 0.5 * double(n) / double(roots.size()))
+                     / (double(n - 1) * double(n - 2) / 2.0);
+        for (auto const& wk : workers)
+            for (size_t v = 0; v < n; ++v) res.score[v] += wk.score[v];
+        for (double& s : res.score) s *= scale;
+        return res;
+    }
+
+private:
+    struct Worker {
+        explicit Worker(size_t n) : score(n, 0.0), dist(n, -1), sigma(n, 0.0), delta(n, 0.0) {
+            order.reserve(n);
+        }
+
+        // Single-source BFS and dependency accumulation from s.
+        void accumulate(const CsrSnapshot& g, uint32_t s) {
+            order.clear();
+            dist[s] = 0;
+            sigma[s] = 1.0;
+            order.push_back(s);
+            for (size_t head = 0; head < order.size(); ++head) {
+                uint32_t v = order[head];
+                for (uint32_t w : g.neighbors(v)) {
+                    if (dist[w] < 0) {
+                        dist[w] = dist[v] + 1;
+                        order.push_back(w);
+                    }
+                    if (dist[w] == dist[v] + 1) sigma[w] += sigma[v];
+                }
+            }
+            // BFS order doubles as the stack: walk it backwards.
+            for (size_t i = order.size(); i-- > 1;) {
+                uint32_t w = order[i];
+                double coeff = (1.0 + delta[w]) / sigma[w];
+                for (uint32_t v : g.neighbors(w))
+                    if (dist[v] == dist[w] - 1) delta[v] += sigma[v] * coeff;
+                score[w] += delta[w];
+            }
+            for (uint32_t v : order) { dist[v] = -1; sigma[v] = 0.0; delta[v] = 0.0; }
+        }
+
+        std::vector<double> score;
+        std::vector<int32_t> dist;
+        std::vector<double> sigma;
+        std::vector<double> delta;
+        std::vector<uint32_t> order;
+    };
+};
+
+}
@@ -0,0 +1,266 @@
+#pragma once
+#include "core/CsrSnapshot.h"
+#include "concurrency/WorkStealing.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <barrier>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace graph {
+
+struct CentralityOptions {
+    double damping = 0.85;          // PageRank follow probability
+    double tolerance = 1e-9;        // stop when the L1 change per iteration drops below this
+    unsigned maxIterations = 100;
+    unsigned threads = 0;           // 0 = every core
+    // Time decay: an interaction `halfLife` seconds older than `decayReference`
+    // counts half as much. 0 disables decay; LLONG_MIN references the newest edge.
+    long long halfLife = 0;
+    long long decayReference = LLONG_MIN;
+};
+
+struct CentralityResult {
+    std::vector<double> score;      // indexed by snapshot dense index
+    unsigned iterations = 0;
+    double residual = 0.0;
+    bool converged = false;
+
+    // Up to k (dense index, score) pairs, best first; ties go to the lower index.
+    std::vector<std::pair<uint32_t, double>> top(size_t k) const {
+        std::vector<std::pair<uint32_t, double>> out;
+        for (uint32_t v = 0; v < score.size(); ++v) out.push_back({ v, score[v] });
+        auto cmp = [](auto const& a, auto const& b) { return a.second != b.second ? a.second > b.second : a.first < b.first; };
+        k = std::min(k, out.size());
+        std::partial_sort(out.begin(), out.begin() + k, out.end(), cmp);
+        out.resize(k);
+        return out;
+    }
+};
+
+// Power-iteration centralities over a CSR snapshot. Every interaction is an
+// undirected weighted link (repeat contacts add weight). Each iteration pulls
+// into each vertex from its incidence run, so vertices update independently and
+// the loop runs in parallel without atomics. Reductions are summed per fixed
+// block in block order, so results do not depend on the thread count.
+class Centrality {
+public:
+    static CentralityResult pageRank(const CsrSnapshot& g, const CentralityOptions& opt = {}) {
+        return rank(g, {}, opt);
+    }
+
+    // PageRank whose teleports (and dangling mass) all land on `seeds`: scores the
+    // graph by proximity to the suspects rather than by global prominence.
+    static CentralityResult personalizedPageRank(const CsrSnapshot& g, const std::vector<uint64_t>& seeds,
+                                                 const CentralityOptions& opt = {}) {
+        std::vector<uint32_t> s;
+        for (uint64_t id : seeds) {
+            uint32_t v = g.indexOf(id);
+            if (v != CsrSnapshot::npos) s.push_back(v);
+        }
+        if (s.empty()) return {};
+        return rank(g, s, opt);
+    }
+
+    // Principal eigenvector of the weighted adjacency matrix (L2-normalised). Uses
+    // the shifted matrix A + I, which has the same eigenvector but cannot oscillate
+    // on bipartite graphs.
+    static CentralityResult eigenvector(const CsrSnapshot& g, const CentralityOptions& opt = {}) {
+        const size_t n = g.nodeCount();
+        CentralityResult res;
+        if (n == 0) return res;
+        auto w = weights(g, opt);
+        std::vector<double> x(n, 1.0 / std::sqrt(double(n))), next(n);
+        Blocks blocks(n, opt.threads);
+
+        for (res.iterations = 1; res.iterations <= opt.maxIterations; ++res.iterations) {
+            blocks.run([&](size_t b, size_t e) {
+                double sq = 0;
+                for (size_t v = b; v < e; ++v) {
+                    double acc = x[v];
+                    pull(g, w, static_cast<uint32_t>(v), [&](uint32_t u, double wt) { acc += wt * x[u]; });
+                    next[v] = acc;
+                    sq += acc * acc;
+                }
+                return sq;
+            });
+            double norm = std::sqrt(blocks.total());
+            if (norm == 0) break;
+            blocks.run([&](size_t b, size_t e) {
+                double diff = 0;
+                for (size_t v = b; v < e; ++v) {
+                    next[v] /= norm;
+                    diff += std::fabs(next[v] - x[v]);
+                }
+                return diff;
+            });
+            x.swap(next);
+            res.residual = blocks.total();
+            if (res.residual < opt.tolerance) { res.converged = true; break; }
+        }
+        res.iterations = std::min(res.iterations, opt.maxIterations);
+        res.score = std::move(x);
+        return res;
+    }
+
+private:
+    static constexpr size_t kBlock = 1024;
+
+    // Fixed vertex blocks with one partial sum each; total() adds them in order.
+    // The worker threads start once and live as long as the Blocks, so every
+    // run() of every iteration costs two barrier waits instead of a spawn and
+    // join per thread. Workers claim blocks from a shared counter.
+    class Blocks {
+    public:
+        Blocks(size_t n, unsigned threads) : n_(n), sums_((n + kBlock - 1) / kBlock) {
+            if (threads == 0) threads = WorkStealing::defaultThreads();
+            threads = static_cast<unsigned>(std::min<size_t>(threads, sums_.size()));
+            if (threads <= 1) return;
+            sync_ = std::make_unique<std::barrier<>>(threads);
+            pool_.reserve(threads - 1);
+            for (unsigned w = 1; w < threads; ++w) pool_.emplace_back([this] { serve(); });
+        }
+
+        ~Blocks() {
+            if (pool_.empty()) return;
+            stop_ = true;
+            sync_->arrive_and_wait();
+            for (auto& t : pool_) t.join();
+        }
+
+        Blocks(const Blocks&) = delete;
+        Blocks& operator=(const Blocks&) = delete;
+
+        // sums[blk] = fn(first vertex, end vertex) for every block.
+        template <typename Fn>
+        void run(Fn&& fn) {
+            task_ = &fn;
+            call_ = [](void* f, size_t b, size_t e) { return (*static_cast<std::remove_reference_t<Fn>*>(f))(b, e); };
+            next_.store(0, std::memory_order_relaxed);
+            if (sync_) sync_->arrive_and_wait();   // release the workers
+            drain();
+            if (sync_) sync_->arrive_and_wait();   // every block is done
+        }
+
+        double total() const {
+            double t = 0;
+            for (double s : sums_) t += s;
+            return t;
+        }
+
+    private:
+        void serve() {
+            for (;;) {
+                sync_->arrive_and_wait();
+                if (stop_) return;
+                drain();
+                sync_->arrive_and_wait();
+            }
+        }
+
+        void drain() {
+            size_t blk;
+            while ((blk = next_.fetch_add(1, std::memory_order_relaxed)) < sums_.size())
+                sums_[blk] = call_(task_, blk * kBlock, std::min(n_, (blk + 1) * kBlock));
+        }
+
+        size_t n_;
+        std::vector<double> sums_;
+        std::unique_ptr<std::barrier<>> sync_;   // null when running on the caller alone
+        std::vector<std::thread> pool_;
+        std::atomic<size_t> next_{0};
+        void* task_ = nullptr;
+        double (*call_)(void*, size_t, size_t) = nullptr;
+        bool stop_ = false;                      // read by workers after a barrier
+    };
+
+    // Per-incidence-slot weights; empty when decay is off (every slot weighs 1).
+    static std::vector<double> weights(const CsrSnapshot& g, const CentralityOptions& opt) {
+        std::vector<double> w;
+        if (opt.halfLife <= 0) return w;
+        long long ref = opt.decayReference;
+        if (ref == LLONG_MIN) {
+            auto ts = g.streamTimes();
+            ref = ts.empty() ? 0 : ts.back();
+        }
+        for (uint32_t v = 0; v < g.nodeCount(); ++v)
+            for (long long t : g.incidentTimes(v))
+                w.push_back(std::exp2(-double(std::max(0LL, ref - t)) / double(opt.halfLife)));
+        return w;
+    }
+
+    // Calls fn(neighbor, weight) for each incidence slot of v.
+    template <typename Fn>
+    static void pull(const CsrSnapshot& g, const std::vector<double>& w, uint32_t v, Fn&& fn) {
+        auto nb = g.incidentNeighbors(v);
+        if (w.empty()) {
+            for (uint32_t u : nb) fn(u, 1.0);
+            return;
+        }
+        const double* wv = w.data() + g.incidenceBegin(v);
+        for (size_t i = 0; i < nb.size(); ++i) fn(nb[i], wv[i]);
+    }
+
+    // PageRank with teleport set `seeds` (empty = uniform).
+    static CentralityResult rank(const CsrSnapshot& g, const std::vector<uint32_t>& seeds,
+                                 const CentralityOptions& opt) {
+        const size_t n = g.nodeCount();
+        CentralityResult res;
+        if (n == 0) return res;
+        auto w = weights(g, opt);
+
+        std::vector<double> teleport(n, seeds.empty() ? 1.0 / n : 0.0);
+        for (uint32_t s : seeds) teleport[s] += 1.0 / seeds.size();
+
+        Blocks blocks(n, opt.threads);
+        std::vector<double> strength(n);
+        blocks.run([&](size_t b, size_t e) {
+            for (size_t v = b; v < e; ++v) {
+                double s = 0;
+                pull(g, w, static_cast<uint32_t>(v), [&](uint32_t, double wt) { s += wt; });
+                strength[v] = s;
+            }
+            return 0.0;
+        });
+
+        std::vector<double> r(teleport), share(n), next(n);
+        const double d = opt.damping;
+        for (res.iterations = 1; res.iterations <= opt.maxIterations; ++res.iterations) {
+            // share[u] = r[u] / strength[u]; vertices with no links spread their rank
+            // through the teleport vector instead.
+            blocks.run([&](size_t b, size_t e) {
+                double dangling = 0;
+                for (size_t u = b; u < e; ++u) {
+                    if (strength[u] > 0) share[u] = r[u] / strength[u];
+                    else { share[u] = 0; dangling += r[u]; }
+                }
+                return dangling;
+            });
+            const double dangling = blocks.total();
+            blocks.run([&](size_t b, size_t e) {
+                double diff = 0;
+                for (size_t v = b; v < e; ++v) {
+                    double acc = 0;
+                    pull(g, w, static_cast<uint32_t>(v), [&](uint32_t u, double wt) { acc += wt * share[u]; });
+                    next[v] = (1.0 - d + d * dangling) * teleport[v] + d * acc;
+                    diff += std::fabs(next[v] - r[v]);
+                }
+                return diff;
+            });
+            r.swap(next);
+            res.residual = blocks.total();
+            if (res.residual < opt.tolerance) { res.converged = true; break; }
+        }
+        res.iterations = std::min(res.iterations, opt.maxIterations);
+        res.score = std::move(r);
+        return res;
+    }
+};
+
+}
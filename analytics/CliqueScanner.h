@@ -0,0 +1,198 @@
+#pragma once
+#include "core/CsrSnapshot.h"
+#include "concurrency/WorkStealing.h"
+#include "analytics/SortedIntersect.h"
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+
+namespace graph {
+
+// Triangle and k-clique enumeration over a CSR snapshot.
+//
+// Every undirected edge is oriented from the lower- to the higher-ranked endpoint,
+// where rank orders vertices by (distinct degree, index). Each vertex then has at
+// most O(sqrt(E)) out-neighbors, so hubs never get expanded against each other, and
+// every clique is found exactly once from its lowest-ranked member. Candidate sets
+// are sorted arrays intersected by a branchless merge (galloping when one side is
+// much shorter), which the compiler can vectorise and which never chases pointers.
+class CliqueScanner {
+public:
+    using Clique = std::vector<uint64_t>;
+
+    explicit CliqueScanner(const CsrSnapshot& g) : g_(g) {
+        const uint32_t n = static_cast<uint32_t>(g.nodeCount());
+        std::vector<uint32_t> deg(n);
+        for (uint32_t v = 0; v < n; ++v) {
+            auto nb = g.neighbors(v);
+            deg[v] = static_cast<uint32_t>(nb.size() - std::count(nb.begin(), nb.end(), v));
+        }
+        order_.resize(n);
+        std::iota(order_.begin(), order_.end(), 0u);
+        std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+            return deg[a] != deg[b] ? deg[a] < deg[b] : a < b;
+        });
+        std::vector<uint32_t> rank(n);
+        for (uint32_t r = 0; r < n; ++r) rank[order_[r]] = r;
+
+        out_off_.assign(n + 1, 0);
+        for (uint32_t r = 0; r < n; ++r) {
+            for (uint32_t w : g.neighbors(order_[r]))
+                if (rank[w] > r) out_.push_back(rank[w]);
+            std::sort(out_.begin() + out_off_[r], out_.end());
+            out_off_[r + 1] = out_.size();
+            max_out_ = std::max<uint64_t>(max_out_, out_off_[r + 1] - out_off_[r]);
+        }
+    }
+
+    // Size of a ∩ b for sorted inputs; when Write is set the result is stored in
+    // `out`, which must have room for min(|a|, |b|) entries.
+    template <bool Write>
+    static size_t intersect(std::span<const uint32_t> a, std::span<const uint32_t> b, uint32_t* out) {
+        return SortedIntersect::run<Write>(a, b, out);
+    }
+
+    uint64_t countTriangles() const { return countCliques(3); }
+    std::vector<Clique> listTriangles() const { return listCliques(3); }
+
+    // Number of k-cliques (k >= 2). threads == 0 uses every core.
+    uint64_t countCliques(unsigned k, unsigned threads = 1) const {
+        if (!feasible(k)) return 0;
+        if (threads == 1) {
+            uint64_t total = 0;
+            Scratch s(k);
+            for (uint32_t r = 0; r < order_.size(); ++r) total += countFrom(r, k, s);
+            return total;
+        }
+        unsigned t = threads ? threads : WorkStealing::defaultThreads();
+        std::vector<Partial<uint64_t>> partial(t, Partial<uint64_t>{ 0, Scratch(k) });
+        WorkStealing::run(order_.size(), t, kGrain, [&](size_t b, size_t e, unsigned w) {
+            for (size_t r = b; r < e; ++r) partial[w].value += countFrom(static_cast<uint32_t>(r), k, partial[w].scratch);
+        });
+        uint64_t total = 0;
+        for (auto const& p : partial) total += p.value;
+        return total;
+    }
+
+    // Every k-clique as ascending node IDs, sorted lexicographically. The parallel
+    // scan produces the same list as the serial one.
+    std::vector<Clique> listCliques(unsigned k, unsigned threads = 1) const {
+        std::vector<Clique> found;
+        if (!feasible(k)) return found;
+        if (threads == 1) {
+            Scratch s(k);
+            for (uint32_t r = 0; r < order_.size(); ++r) listFrom(r, k, s, found);
+        } else {
+            unsigned t = threads ? threads : WorkStealing::defaultThreads();
+            std::vector<Partial<std::vector<Clique>>> partial(t, Partial<std::vector<Clique>>{ {}, Scratch(k) });
+            WorkStealing::run(order_.size(), t, kGrain, [&](size_t b, size_t e, unsigned w) {
+                for (size_t r = b; r < e; ++r) listFrom(static_cast<uint32_t>(r), k, partial[w].scratch, partial[w].value);
+            });
+            size_t total = 0;
+            for (auto const& p : partial) total += p.value.size();
+            found.reserve(total);
+            for (auto& p : partial)
+                std::move(p.value.begin(), p.value.end(), std::back_inserter(found));
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    // Per-thread working memory: one candidate buffer per recursion level.
+    struct Scratch {
+        explicit Scratch(unsigned k) : levels(k > 2 ? k - 2 : 0) {}
+        std::vector<std::vector<uint32_t>> levels;
+        std::vector<uint32_t> stack;
+    };
+
+    // Cliques whose lowest-ranked member is r. The per-root pieces let callers
+    // split the scan however they like.
+    uint64_t countFrom(uint32_t r, unsigned k, Scratch& s) const {
+        if (k < 2) return 0;
+        if (k == 2) return outs(r).size();
+        if (k == 3) {
+            uint64_t c = 0;
+            for (uint32_t u : outs(r)) c += intersect<false>(outs(r), outs(u), nullptr);
+            return c;
+        }
+        return expandCount(outs(r), k - 1, s, 0);
+    }
+
+    void listFrom(uint32_t r, unsigned k, Scratch& s, std::vector<Clique>& found) const {
+        if (k < 2) return;
+        s.stack.assign(1, r);
+        expandList(outs(r), k - 1, s, 0, found);
+    }
+
+private:
+    // Roots handed out per work-stealing chunk; small because hub roots are expensive.
+    static constexpr size_t kGrain = 64;
+
+    template <typename T>
+    struct alignas(64) Partial {
+        T value;
+        Scratch scratch;
+    };
+
+    // The lowest-ranked member of a k-clique has the other k-1 as out-neighbors, so
+    // no k beyond max out-degree + 1 can match. Checked before Scratch is sized by k.
+    bool feasible(unsigned k) const { return k >= 2 && k <= max_out_ + 1; }
+
+    std::span<const uint32_t> outs(uint32_t r) const {
+        return { out_.data() + out_off_[r], out_.data() + out_off_[r + 1] };
+    }
+
+    // `need` more members must be chosen from `cand`.
+    uint64_t expandCount(std::span<const uint32_t> cand, unsigned need, Scratch& s, unsigned lvl) const {
+        if (need == 1) return cand.size();
+        uint64_t c = 0;
+        auto& buf = s.levels[lvl];
+        for (uint32_t u : cand) {
+            auto ou = outs(u);
+            if (ou.size() + 1 < need) continue;
+            buf.resize(std::min(cand.size(), ou.size()));
+            size_t m = intersect<true>(cand, ou, buf.data());
+            if (need == 2) { c += m; continue; }
+            if (m + 1 < need) continue;
+            c += expandCount({ buf.data(), m }, need - 1, s, lvl + 1);
+        }
+        return c;
+    }
+
+    void expandList(std::span<const uint32_t> cand, unsigned need, Scratch& s, unsigned lvl,
+                    std::vector<Clique>& found) const {
+        if (need == 0) { emit(s.stack, found); return; }
+        for (uint32_t u : cand) {
+            s.stack.push_back(u);
+            if (need == 1) {
+                emit(s.stack, found);
+            } else {
+                auto ou = outs(u);
+                auto& buf = s.levels[lvl];
+                buf.resize(std::min(cand.size(), ou.size()));
+                size_t m = intersect<true>(cand, ou, buf.data());
+                if (m + 1 >= need) expandList({ buf.data(), m }, need - 1, s, lvl + 1, found);
+            }
+            s.stack.pop_back();
+        }
+    }
+
+    void emit(const std::vector<uint32_t>& ranks, std::vector<Clique>& found) const {
+        Clique c;
+        c.reserve(ranks.size());
+        for (uint32_t r : ranks) c.push_back(g_.idOf(order_[r]));
+        std::sort(c.begin(), c.end());
+        found.push_back(std::move(c));
+    }
+
+    const CsrSnapshot& g_;
+    std::vector<uint32_t> order_;     // rank -> dense vertex
+    std::vector<uint64_t> out_off_;
+    std::vector<uint32_t> out_;       // higher-ranked neighbors, by rank
+    uint64_t max_out_ = 0;
+};
+
+}
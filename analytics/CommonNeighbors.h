@@ -0,0 +1,49 @@
+#pragma once
+#include "core/GraphStore.h"
+#include <vector>
+#include <cstdint>
+
+namespace graph {
+
+// A node both targets have been in contact with, and when.
+struct Witness {
+    uint64_t id;
+    uint32_t degree;                 // total interactions of the witness
+    std::vector<long long> timesA;   // contacts with target A, oldest first
+    std::vector<long long> timesB;   // contacts with target B, oldest first
+};
+
+// Shared-neighborhood queries for a pair of nodes, answered from the store's
+// per-node sorted neighbor lists with SortedIntersect: a linear merge for
+// similar-sized lists, galloping through the longer one when a target is a hub.
+// Nothing is built or sorted per query, and each query reads everything it needs
+// under one store lock, so concurrent ingest never mixes two versions into one
+// answer.
+class CommonNeighbors {
+public:
+    // IDs of the common neighbors of a and b, ascending.
+    static std::vector<uint64_t> shared(const GraphStore& store, uint64_t a, uint64_t b) {
+        return store.getCommonNeighbors(a, b);
+    }
+
+    struct Overlap { size_t shared = 0; size_t combined = 0; };
+
+    // |N(a) ∩ N(b)| and |N(a) ∪ N(b)| without materialising either set.
+    static Overlap overlap(const GraphStore& store, uint64_t a, uint64_t b) {
+        auto [shared, combined] = store.getNeighborOverlap(a, b);
+        return { shared, combined };
+    }
+
+    // Every common neighbor of a and b with its contact history to each, from the
+    // pair index (already oldest first).
+    static std::vector<Witness> witnesses(const GraphStore& store, uint64_t a, uint64_t b) {
+        std::vector<Witness> out;
+        store.forEachCommonNeighbor(a, b, [&](uint64_t w, uint32_t degree,
+                                              std::vector<long long> timesA, std::vector<long long> timesB) {
+            out.push_back({ w, degree, std::move(timesA), std::move(timesB) });
+        });
+        return out;
+    }
+};
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "core/CsrSnapshot.h"
+#include "concurrency/WorkStealing.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace graph {
+
+// Neighborhood-overlap scores for one candidate pair.
+struct SimilarPair {
+    uint64_t a, b;
+    uint32_t common;              // shared neighbors
+    double jaccard;               // common / |N(a) ∪ N(b)|
+    double adamicAdar;            // Σ 1 / ln(deg w) over shared w
+    double resourceAllocation;    // Σ 1 / deg w over shared w
+};
+
+struct LinkPredictionOptions {
+    enum class Metric { Jaccard, AdamicAdar, ResourceAllocation };
+    Metric rankBy = Metric::AdamicAdar;
+    size_t topPerNode = 10;
+    bool skipAdjacent = true;     // only score pairs with no direct edge (hidden links)
+    unsigned threads = 0;         // 0 = every core
+};
+
+// Batch link prediction over a CSR snapshot: every pair that shares at least one
+// neighbor is found by two-hop enumeration (u -> w -> v) and scored with Jaccard,
+// Adamic-Adar and resource allocation in the same pass. Sources are spread over
+// the work-stealing loop, each worker with dense accumulators reset only where
+// touched. A node's list depends only on that node, so output is identical for
+// any thread count.
+class LinkPrediction {
+public:
+    using Options = LinkPredictionOptions;
+
+    // perNode[v] holds v's best candidates (a == idOf(v)), best first.
+    static std::vector<std::vector<SimilarPair>> topPerNode(const CsrSnapshot& g, const Options& opt = {}) {
+        const size_t n = g.nodeCount();
+        std::vector<std::vector<SimilarPair>> perNode(n);
+        if (n == 0 || opt.topPerNode == 0) return perNode;
+
+        std::vector<uint32_t> deg(n);
+        for (uint32_t v = 0; v < n; ++v) deg[v] = degreeOf(g, v);
+
+        unsigned threads = opt.threads ? opt.threads : WorkStealing::defaultThreads();
+        threads = static_cast<unsigned>(std::min<size_t>(threads, n));
+        std::vector<Scratch> scratch(threads, Scratch(n));
+        WorkStealing::run(n, threads, 16, [&](size_t b, size_t e, unsigned w) {
+            for (size_t u = b; u < e; ++u)
+                perNode[u] = scoreFrom(g, deg, static_cast<uint32_t>(u), opt, scratch[w]);
+        });
+        return perNode;
+    }
+
+    // The k best pairs in the whole graph (each pair once, a < b). Any pair in the
+    // global top k is also in the top k of both its endpoints, so per-node lists of
+    // length k are enough to build it.
+    static std::vector<SimilarPair> topPairs(const CsrSnapshot& g, size_t k, Options opt = {}) {
+        opt.topPerNode = k;
+        std::vector<SimilarPair> all;
+        for (auto& list : topPerNode(g, opt))
+            for (auto& p : list)
+                if (p.a < p.b) all.push_back(p);
+        Better cmp{ opt.rankBy };
+        k = std::min(k, all.size());
+        std::partial_sort(all.begin(), all.begin() + k, all.end(), cmp);
+        all.resize(k);
+        return all;
+    }
+
+private:
+    struct Scratch {
+        explicit Scratch(size_t n) : common(n, 0), aa(n, 0.0), ra(n, 0.0) {}
+        std::vector<uint32_t> common;
+        std::vector<double> aa, ra;
+        std::vector<uint32_t> touched;
+    };
+
+    // Distinct neighbors other than v itself.
+    static uint32_t degreeOf(const CsrSnapshot& g, uint32_t v) {
+        auto nb = g.neighbors(v);
+        return static_cast<uint32_t>(nb.size() - (std::binary_search(nb.begin(), nb.end(), v) ? 1 : 0));
+    }
+
+    static double metric(const SimilarPair& p, Options::Metric m) {
+        switch (m) {
+            case Options::Metric::Jaccard: return p.jaccard;
+            case Options::Metric::ResourceAllocation: return p.resourceAllocation;
+            default: return p.adamicAdar;
+        }
+    }
+
+    // Higher score first; ties by (a, b) so every ordering is total.
+    struct Better {
+        Options::Metric m;
+        bool operator()(const SimilarPair& x, const SimilarPair& y) const {
+            double sx = metric(x, m), sy = metric(y, m);
+            if (sx != sy) return sx > sy;
+            return x.a != y.a ? x.a < y.a : x.b < y.b;
+        }
+    };
+
+    static std::vector<SimilarPair> scoreFrom(const CsrSnapshot& g, const std::vector<uint32_t>& deg,
+                                              uint32_t u, const Options& opt, Scratch& s) {
+        for (uint32_t w : g.neighbors(u)) {
+            if (w == u) continue;
+            double aa = 1.0 / std::log(double(deg[w]));   // deg[w] >= 2 whenever it is shared
+            double ra = 1.0 / double(deg[w]);
+            for (uint32_t v : g.neighbors(w)) {
+                if (v == u || v == w) continue;
+                if (s.common[v]++ == 0) s.touched.push_back(v);
+                s.aa[v] += aa;
+                s.ra[v] += ra;
+            }
+        }
+
+        std::vector<SimilarPair> out;
+        out.reserve(s.touched.size());
+        std::sort(s.touched.begin(), s.touched.end());
+        for (uint32_t v : s.touched) {
+            if (!(opt.skipAdjacent && g.adjacent(u, v))) {
+                uint32_t c = s.common[v];
+                out.push_back({ g.idOf(u), g.idOf(v), c, double(c) / double(deg[u] + deg[v] - c), s.aa[v], s.ra[v] });
+            }
+            s.common[v] = 0;
+            s.aa[v] = 0.0;
+            s.ra[v] = 0.0;
+        }
+        s.touched.clear();
+
+        Better cmp{ opt.rankBy };
+        size_t k = std::min(opt.topPerNode, out.size());
+        std::partial_sort(out.begin(), out.begin() + k, out.end(), cmp);
+        out.resize(k);
+        return out;
+    }
+};
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace graph {
+
+// Intersection kernels for ascending, duplicate-free integer arrays (CSR neighbor
+// runs by dense index, the store's neighbor lists by node ID). Balanced inputs use a branchless merge; when one side is more than
+// kSkew times longer, the short side's elements are located in the long side by
+// galloping, finishing each search with a fixed-width block compare that counts
+// how many of the next kLanes values are smaller. Both loops are written so the
+// compiler can vectorise them without intrinsics.
+struct SortedIntersect {
+    static constexpr size_t kSkew = 32;
+    static constexpr size_t kLanes = 8;
+
+    // |a ∩ b|; with Write the elements are also stored in `out`, which needs room
+    // for min(|a|, |b|) values.
+    template <bool Write, typename T>
+    static size_t run(std::span<const T> a, std::span<const T> b, T* out) {
+        if (a.size() > b.size()) std::swap(a, b);
+        if (a.empty()) return 0;
+        return (a.size() * kSkew < b.size()) ? gallop<Write, T>(a, b, out) : merge<Write, T>(a, b, out);
+    }
+
+    template <typename T>
+    static size_t count(std::span<const T> a, std::span<const T> b) {
+        return run<false, T>(a, b, nullptr);
+    }
+
+private:
+    template <bool Write, typename T>
+    static size_t merge(std::span<const T> a, std::span<const T> b, T* out) {
+        size_t i = 0, j = 0, n = 0;
+        while (i < a.size() && j < b.size()) {
+            T x = a[i], y = b[j];
+            if constexpr (Write) out[n] = x;
+            n += (x == y);
+            i += (x <= y);
+            j += (y <= x);
+        }
+        return n;
+    }
+
+    template <bool Write, typename T>
+    static size_t gallop(std::span<const T> a, std::span<const T> b, T* out) {
+        size_t n = 0, lo = 0;
+        const size_t nb = b.size();
+        for (T x : a) {
+            // Exponential search for a window [lo, hi) whose end is >= x.
+            size_t step = kLanes, hi = lo;
+            while (hi < nb && b[hi] < x) { lo = hi + 1; hi += step; step <<= 1; }
+            hi = std::min(hi + 1, nb);
+            // Narrow to one block, then count lanes below x instead of branching.
+            while (hi - lo > kLanes) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (b[mid] < x) lo = mid + 1; else hi = mid + 1;
+            }
+            size_t below = 0;
+            for (size_t k = lo; k < hi; ++k) below += (b[k] < x);
+            lo += below;
+            if (lo == nb) break;
+            if (b[lo] == x) { if constexpr (Write) out[n] = x; ++n; }
+        }
+        return n;
+    }
+};
+
+}
@@ -0,0 +1,279 @@
+#pragma once
+#include "core/CsrSnapshot.h"
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <utility>
+
+namespace graph {
+
+// A time-respecting route: nodes[i] -> nodes[i+1] over an edge at times[i].
+// Times never decrease along a journey. A journey from a node to itself has one
+// node and no hops; an empty journey means no route exists.
+struct Journey {
+    std::vector<uint64_t> nodes;
+    std::vector<long long> times;
+
+    bool found() const { return !nodes.empty(); }
+    size_t hops() const { return times.size(); }
+    long long departure() const { return times.empty() ? 0 : times.front(); }
+    long long arrival() const { return times.empty() ? 0 : times.back(); }
+};
+
+// Temporal path queries over the chronological edge stream of a CSR snapshot.
+// Edges are undirected; a journey may only use edges inside [from, until] and
+// consecutive hops must not go back in time (equal timestamps may chain).
+//
+// Each query is one pass over the stream with per-vertex state and parent
+// pointers, so cost is O(V + E) rather than a search over (node, time) states:
+//  - EarliestArrival: forward sweep, a vertex is settled the first time it is reached
+//  - LatestDeparture: the same sweep run backwards from the deadline
+//  - Fastest:         forward sweep keeping each vertex's latest possible start
+//  - FewestHops:      forward sweep keeping each vertex's fewest hops so far
+class TemporalPaths {
+public:
+    enum class Mode { EarliestArrival, LatestDeparture, Fastest, FewestHops };
+
+    explicit TemporalPaths(const CsrSnapshot& g) : g_(g) {}
+
+    Journey find(Mode mode, uint64_t src, uint64_t dst,
+                 long long from = LLONG_MIN, long long until = LLONG_MAX) const {
+        switch (mode) {
+            case Mode::EarliestArrival: return earliestArrival(src, dst, from, until);
+            case Mode::LatestDeparture: return latestDeparture(src, dst, from, until);
+            case Mode::Fastest:         return fastest(src, dst, from, until);
+            default:                    return fewestHops(src, dst, from, until);
+        }
+    }
+
+    Journey earliestArrival(uint64_t src, uint64_t dst,
+                            long long from = LLONG_MIN, long long until = LLONG_MAX) const {
+        uint32_t s, d;
+        Journey j;
+        if (!endpoints(src, dst, s, d, j)) return j;
+
+        auto tsv = g_.streamTimes();
+        std::vector<long long> arr(g_.nodeCount(), LLONG_MAX);
+        std::vector<uint32_t> via(g_.nodeCount(), CsrSnapshot::npos);
+        arr[s] = from;
+        auto [b, e] = window(from, until);
+        sweep(b, e, [&](size_t i) {
+            long long t = tsv[i];
+            auto step = [&](uint32_t x, uint32_t y) {
+                if (arr[x] > t || t >= arr[y]) return false;
+                arr[y] = t;
+                via[y] = static_cast<uint32_t>(i);
+                return true;
+            };
+            return relaxBoth(i, step);
+        }, [&] { return via[d] != CsrSnapshot::npos; });
+
+        if (via[d] == CsrSnapshot::npos) return {};
+        for (uint32_t v = d; v != s;) {
+            size_t i = via[v];
+            j.nodes.push_back(g_.idOf(v));
+            j.times.push_back(tsv[i]);
+            v = otherEnd(i, v);
+        }
+        j.nodes.push_back(src);
+        std::reverse(j.nodes.begin(), j.nodes.end());
+        std::reverse(j.times.begin(), j.times.end());
+        return j;
+    }
+
+    Journey latestDeparture(uint64_t src, uint64_t dst,
+                            long long from = LLONG_MIN, long long until = LLONG_MAX) const {
+        uint32_t s, d;
+        Journey j;
+        if (!endpoints(src, dst, s, d, j)) return j;
+
+        auto tsv = g_.streamTimes();
+        std::vector<long long> dep(g_.nodeCount(), LLONG_MIN);
+        std::vector<uint32_t> next(g_.nodeCount(), CsrSnapshot::npos);
+        dep[d] = until;
+        auto [b, e] = window(from, until);
+        sweepBackward(b, e, [&](size_t i) {
+            long long t = tsv[i];
+            auto step = [&](uint32_t x, uint32_t y) {
+                // leaving x at t works if y can still reach dst departing at or after t
+                if (dep[y] < t || t <= dep[x]) return false;
+                dep[x] = t;
+                next[x] = static_cast<uint32_t>(i);
+                return true;
+            };
+            return relaxBoth(i, step);
+        }, [&] { return next[s] != CsrSnapshot::npos; });
+
+        if (next[s] == CsrSnapshot::npos) return {};
+        j.nodes.push_back(src);
+        for (uint32_t v = s; v != d;) {
+            size_t i = next[v];
+            j.times.push_back(tsv[i]);
+            v = otherEnd(i, v);
+            j.nodes.push_back(g_.idOf(v));
+        }
+        return j;
+    }
+
+    Journey fastest(uint64_t src, uint64_t dst,
+                    long long from = LLONG_MIN, long long until = LLONG_MAX) const {
+        uint32_t s, d;
+        Journey j;
+        if (!endpoints(src, dst, s, d, j)) return j;
+
+        // Labels are (latest start from src, arrival); each vertex only ever needs
+        // its newest label, since that one has both the latest arrival so far and
+        // the latest start. Older labels stay in the pool for path reconstruction.
+        std::vector<Label> pool;
+        std::vector<uint32_t> last(g_.nodeCount(), CsrSnapshot::npos);
+        uint32_t best = CsrSnapshot::npos;
+        long long bestSpan = LLONG_MAX;
+        auto tsv = g_.streamTimes();
+        auto [b, e] = window(from, until);
+        sweep(b, e, [&](size_t i) {
+            long long t = tsv[i];
+            auto step = [&](uint32_t x, uint32_t y) {
+                if (y == s) return false;
+                long long start;
+                uint32_t parent;
+                if (x == s) { start = t; parent = CsrSnapshot::npos; }
+                else if (last[x] != CsrSnapshot::npos) { start = pool[last[x]].key; parent = last[x]; }
+                else return false;
+                if (last[y] != CsrSnapshot::npos && pool[last[y]].key >= start) return false;
+                last[y] = static_cast<uint32_t>(pool.size());
+                pool.push_back({ y, parent, start, t });
+                if (y == d && t - start < bestSpan) { bestSpan = t - start; best = last[y]; }
+                return true;
+            };
+            return relaxBoth(i, step);
+        }, [] { return false; });
+
+        if (best == CsrSnapshot::npos) return {};
+        unwind(pool, best, src, j);
+        return j;
+    }
+
+    Journey fewestHops(uint64_t src, uint64_t dst,
+                       long long from = LLONG_MIN, long long until = LLONG_MAX) const {
+        uint32_t s, d;
+        Journey j;
+        if (!endpoints(src, dst, s, d, j)) return j;
+
+        // Labels are (hops, arrival); a vertex's newest label always has the fewest
+        // hops among everything that arrived by now, so it is the only one extended.
+        std::vector<Label> pool;
+        std::vector<uint32_t> last(g_.nodeCount(), CsrSnapshot::npos);
+        pool.push_back({ s, CsrSnapshot::npos, 0, from });
+        last[s] = 0;
+        auto tsv = g_.streamTimes();
+        auto [b, e] = window(from, until);
+        sweep(b, e, [&](size_t i) {
+            long long t = tsv[i];
+            auto step = [&](uint32_t x, uint32_t y) {
+                if (last[x] == CsrSnapshot::npos) return false;
+                long long hops = pool[last[x]].key + 1;
+                if (last[y] != CsrSnapshot::npos && pool[last[y]].key <= hops) return false;
+                uint32_t parent = last[x];
+                last[y] = static_cast<uint32_t>(pool.size());
+                pool.push_back({ y, parent, hops, t });
+                return true;
+            };
+            return relaxBoth(i, step);
+        }, [&] { return last[d] != CsrSnapshot::npos && pool[last[d]].key == 1; });
+
+        if (last[d] == CsrSnapshot::npos) return {};
+        // The source label is the root of every chain; drop it while unwinding.
+        unwind(pool, last[d], src, j, 0);
+        return j;
+    }
+
+private:
+    struct Label {
+        uint32_t vertex;
+        uint32_t parent;   // pool index, npos for a hop straight out of the source
+        long long key;     // start time (fastest) or hop count (fewest hops)
+        long long arrival;
+    };
+
+    // Resolves both endpoints; handles the trivial src == dst journey.
+    bool endpoints(uint64_t src, uint64_t dst, uint32_t& s, uint32_t& d, Journey& j) const {
+        s = g_.indexOf(src);
+        d = g_.indexOf(dst);
+        if (s == CsrSnapshot::npos || d == CsrSnapshot::npos) return false;
+        if (s == d) { j.nodes.push_back(src); return false; }
+        return true;
+    }
+
+    // Stream positions [b, e) whose timestamps fall inside [from, until].
+    std::pair<size_t, size_t> window(long long from, long long until) const {
+        auto tsv = g_.streamTimes();
+        size_t b = std::lower_bound(tsv.begin(), tsv.end(), from) - tsv.begin();
+        size_t e = std::upper_bound(tsv.begin(), tsv.end(), until) - tsv.begin();
+        return { b, std::max(b, e) };
+    }
+
+    uint32_t otherEnd(size_t i, uint32_t v) const {
+        uint32_t a = g_.streamSources()[i];
+        return (a == v) ? g_.streamTargets()[i] : a;
+    }
+
+    template <typename Step>
+    bool relaxBoth(size_t i, Step& step) const {
+        uint32_t a = g_.streamSources()[i], b = g_.streamTargets()[i];
+        bool changed = step(a, b);
+        if (a != b) changed |= step(b, a);
+        return changed;
+    }
+
+    // Feeds edges [b, e) to relax in time order. Edges sharing a timestamp are
+    // replayed until nothing changes, so chains inside one instant are found
+    // regardless of their order in the stream.
+    template <typename Relax, typename Done>
+    void sweep(size_t b, size_t e, Relax&& relax, Done&& done) const {
+        auto tsv = g_.streamTimes();
+        for (size_t i = b; i < e;) {
+            size_t k = i + 1;
+            while (k < e && tsv[k] == tsv[i]) ++k;
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (size_t x = i; x < k; ++x) changed |= relax(x);
+                if (k - i == 1) break;
+            }
+            if (done()) return;
+            i = k;
+        }
+    }
+
+    template <typename Relax, typename Done>
+    void sweepBackward(size_t b, size_t e, Relax&& relax, Done&& done) const {
+        auto tsv = g_.streamTimes();
+        for (size_t k = e; k > b;) {
+            size_t i = k - 1;
+            while (i > b && tsv[i - 1] == tsv[k - 1]) --i;
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (size_t x = k; x > i; --x) changed |= relax(x - 1);
+                if (k - i == 1) break;
+            }
+            if (done()) return;
+            k = i;
+        }
+    }
+
+    // Follows parent pointers from `at` back to the source and fills j in order.
+    void unwind(const std::vector<Label>& pool, uint32_t at, uint64_t src, Journey& j,
+                uint32_t root = CsrSnapshot::npos) const {
+        for (uint32_t l = at; l != root && l != CsrSnapshot::npos; l = pool[l].parent) {
+            j.nodes.push_back(g_.idOf(pool[l].vertex));
+            j.times.push_back(pool[l].arrival);
+        }
+        j.nodes.push_back(src);
+        std::reverse(j.nodes.begin(), j.nodes.end());
+        std::reverse(j.times.begin(), j.times.end());
+    }
+
+    const CsrSnapshot& g_;
+};
+
+}
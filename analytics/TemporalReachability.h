@@ -0,0 +1,123 @@
+#pragma once
+#include "core/CsrSnapshot.h"
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+namespace graph {
+
+// Batch temporal reachability: who could have heard from whom, and how early.
+// Both queries make a single chronological pass over the snapshot's edge stream
+// no matter how many targets (or sources) are asked about. Journeys follow the
+// same rules as TemporalPaths: undirected edges inside [from, until], times never
+// decreasing, and edges sharing a timestamp may chain.
+class TemporalReachability {
+public:
+    static constexpr long long kUnreachable = LLONG_MAX;
+
+    explicit TemporalReachability(const CsrSnapshot& g) : g_(g) {}
+
+    // Earliest arrival at each target for information leaving `source` at `from`.
+    // result[i] belongs to targets[i]; kUnreachable when no journey exists. The
+    // source itself (or any unknown ID) reports `from` / kUnreachable respectively.
+    std::vector<long long> oneToMany(uint64_t source, const std::vector<uint64_t>& targets,
+                                     long long from = LLONG_MIN, long long until = LLONG_MAX) const {
+        auto rows = manyToMany({ source }, targets, from, until);
+        return rows.front();
+    }
+
+    // result[i][k] is the earliest arrival at targets[k] from sources[i]. Sources are
+    // packed 64 to a word so each edge moves whole frontiers with a few AND/OR ops.
+    std::vector<std::vector<long long>> manyToMany(const std::vector<uint64_t>& sources,
+                                                   const std::vector<uint64_t>& targets,
+                                                   long long from = LLONG_MIN,
+                                                   long long until = LLONG_MAX) const {
+        const size_t n = g_.nodeCount();
+        const size_t words = (sources.size() + 63) / 64;
+        std::vector<std::vector<long long>> result(sources.size(),
+                                                   std::vector<long long>(targets.size(), kUnreachable));
+        if (sources.empty() || targets.empty() || n == 0) return result;
+
+        // dense vertex -> first slot in `targets` (duplicates are copied at the end)
+        std::vector<uint32_t> slot(n, CsrSnapshot::npos);
+        for (size_t k = 0; k < targets.size(); ++k) {
+            uint32_t v = g_.indexOf(targets[k]);
+            if (v != CsrSnapshot::npos && slot[v] == CsrSnapshot::npos) slot[v] = static_cast<uint32_t>(k);
+        }
+
+        std::vector<uint64_t> reached(n * words, 0);
+        size_t pending = 0; // (source, target) pairs still unreached
+        auto settle = [&](uint32_t v, size_t w, uint64_t bits, long long t) {
+            if (slot[v] == CsrSnapshot::npos) return;
+            while (bits) {
+                size_t i = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                result[i][slot[v]] = t;
+                --pending;
+            }
+        };
+        for (uint32_t v = 0; v < n; ++v)
+            if (slot[v] != CsrSnapshot::npos) pending += sources.size();
+        for (size_t i = 0; i < sources.size(); ++i) {
+            uint32_t v = g_.indexOf(sources[i]);
+            if (v == CsrSnapshot::npos) continue;
+            uint64_t bit = uint64_t(1) << (i % 64);
+            uint64_t& word = reached[v * words + i / 64];
+            if (word & bit) continue;
+            word |= bit;
+            settle(v, i / 64, bit, from);
+        }
+
+        auto src = g_.streamSources();
+        auto tgt = g_.streamTargets();
+        auto tsv = g_.streamTimes();
+        size_t b = std::lower_bound(tsv.begin(), tsv.end(), from) - tsv.begin();
+        size_t e = std::upper_bound(tsv.begin(), tsv.end(), until) - tsv.begin();
+
+        // Pushes x's frontier into y; returns true if y learned anything new.
+        auto spread = [&](uint32_t x, uint32_t y, long long t) {
+            bool changed = false;
+            const uint64_t* rx = &reached[x * words];
+            uint64_t* ry = &reached[y * words];
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t fresh = rx[w] & ~ry[w];
+                if (!fresh) continue;
+                ry[w] |= fresh;
+                settle(y, w, fresh, t);
+                changed = true;
+            }
+            return changed;
+        };
+
+        for (size_t i = b; i < e && pending > 0;) {
+            size_t k = i + 1;
+            while (k < e && tsv[k] == tsv[i]) ++k;
+            // Same-instant edges are replayed until the frontiers stop moving.
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (size_t x = i; x < k; ++x) {
+                    uint32_t u = src[x], v = tgt[x];
+                    if (u == v) continue;
+                    changed |= spread(u, v, tsv[x]);
+                    changed |= spread(v, u, tsv[x]);
+                }
+                if (k - i == 1) break;
+            }
+            i = k;
+        }
+
+        // Repeated targets share their first occurrence's answer.
+        for (size_t k = 0; k < targets.size(); ++k) {
+            uint32_t v = g_.indexOf(targets[k]);
+            if (v == CsrSnapshot::npos || slot[v] == k) continue;
+            for (auto& row : result) row[k] = row[slot[v]];
+        }
+        return result;
+    }
+
+private:
+    const CsrSnapshot& g_;
+};
+
+}
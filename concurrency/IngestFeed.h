@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <charconv>
+#include <ctime>
+#include <cstdint>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "concurrency/IngestQueue.h"
+
+namespace graph {
+
+// One collector: a thread that reads "source target [timestamp]" lines from a
+// file or a named pipe and pushes each edge into a shared IngestQueue. Several
+// feeds on one queue are its concurrent producers. A regular file is read to
+// the end; a pipe is kept open (even with no writer attached) until stop().
+// Lines that do not parse are counted and skipped; a missing timestamp means
+// "now", as with connect.
+class IngestFeed {
+public:
+    struct Stats {
+        uint64_t lines = 0;
+        uint64_t pushed = 0;
+        uint64_t malformed = 0;
+        bool running = false;
+    };
+
+    // Returns nullptr and sets `error` if `path` cannot be opened.
+    static std::unique_ptr<IngestFeed> open(IngestQueue& queue, const std::string& path, std::string& error) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) { error = "cannot open " + path; return nullptr; }
+        bool pipe = S_ISFIFO(st.st_mode);
+        // O_RDWR keeps a writer reference on the pipe, so it never reads as
+        // ended between one writer closing and the next opening it.
+        int fd = ::open(path.c_str(), (pipe ? O_RDWR : O_RDONLY) | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) { error = "cannot open " + path; return nullptr; }
+        return std::unique_ptr<IngestFeed>(new IngestFeed(queue, path, fd));
+    }
+
+    ~IngestFeed() { stop(); }
+
+    IngestFeed(const IngestFeed&) = delete;
+    IngestFeed& operator=(const IngestFeed&) = delete;
+
+    // Stops reading; records already pushed stay in the queue.
+    void stop() {
+        stopping_.store(true);
+        if (reader_.joinable()) reader_.join();
+    }
+
+    const std::string& path() const { return path_; }
+
+    Stats stats() const {
+        Stats s;
+        s.lines = lines_.load(std::memory_order_relaxed);
+        s.pushed = pushed_.load(std::memory_order_relaxed);
+        s.malformed = malformed_.load(std::memory_order_relaxed);
+        s.running = !finished_.load();
+        return s;
+    }
+
+    // Parses "source target [timestamp]", separated by spaces, tabs or commas.
+    static bool parseLine(std::string_view line, uint64_t& src, uint64_t& tgt, long long& ts, bool& hasTs) {
+        const char* p = line.data();
+        const char* end = p + line.size();
+        auto skip = [&] { while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r')) ++p; };
+        skip();
+        auto r = std::from_chars(p, end, src);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        skip();
+        r = std::from_chars(p, end, tgt);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        skip();
+        hasTs = p < end;
+        if (hasTs) {
+            auto t = std::from_chars(p, end, ts);
+            if (t.ec != std::errc()) return false;
+            p = t.ptr;
+            skip();
+        }
+        return p == end;
+    }
+
+private:
+    IngestFeed(IngestQueue& queue, std::string path, int fd) : queue_(queue), path_(std::move(path)), fd_(fd) {
+        reader_ = std::thread([this] { readLoop(); });
+    }
+
+    void readLoop() {
+        std::string pending;
+        char buf[1 << 16];
+        while (!stopping_.load()) {
+            ssize_t n = ::read(fd_, buf, sizeof(buf));
+            if (n > 0) {
+                pending.append(buf, n);
+                size_t start = 0, nl;
+                while ((nl = pending.find('\n', start)) != std::string::npos) {
+                    consume(std::string_view(pending).substr(start, nl - start));
+                    start = nl + 1;
+                }
+                pending.erase(0, start);
+                continue;
+            }
+            if (n == 0) break;   // end of a regular file
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) break;
+            pollfd pfd{ fd_, POLLIN, 0 };
+            ::poll(&pfd, 1, 50);   // wake periodically to notice stop()
+        }
+        if (!pending.empty()) consume(pending);
+        ::close(fd_);
+        finished_.store(true);
+    }
+
+    void consume(std::string_view line) {
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) return;
+        lines_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t src, tgt;
+        long long ts = 0;
+        bool hasTs;
+        if (!parseLine(line, src, tgt, ts, hasTs)) {
+            malformed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!hasTs) ts = std::time(nullptr);
+        if (queue_.push(src, tgt, ts)) pushed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    IngestQueue& queue_;
+    std::string path_;
+    int fd_;
+    std::thread reader_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> finished_{false};
+    std::atomic<uint64_t> lines_{0};
+    std::atomic<uint64_t> pushed_{0};
+    std::atomic<uint64_t> malformed_{0};
+};
+
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "concurrency/MpscRing.h"
+#include "core/GraphStore.h"
+
+namespace graph {
+
+// Many collectors (mail, chat, transfers) feeding one store. Producers drop
+// raw records into a lock-free ring and return immediately; a single applier
+// thread drains the ring in batches and hands each to GraphStore::addEdges, so
+// the store's lock is taken once per batch and producers never contend on it.
+// When the ring is full, tryPush refuses the record and push waits for room,
+// which pushes back on collectors that outrun the applier. Nobody spins while
+// waiting: an idle applier sleeps in std::atomic::wait on a wake counter that
+// producers and stop() bump, and push (ring full) and flush() sleep on the
+// applied counter, which the applier bumps after each batch.
+class IngestQueue {
+public:
+    struct Options {
+        size_t capacity = size_t(1) << 16;
+        size_t maxBatch = 4096;
+    };
+
+    struct Stats {
+        uint64_t enqueued = 0;
+        uint64_t applied = 0;
+        uint64_t rejected = 0;      // tryPush calls refused because the ring was full
+        uint64_t stalls = 0;        // push calls that had to wait for room
+        uint64_t batches = 0;
+        double recordsPerSec = 0;   // applied since the queue started
+        double meanLatencyUs = 0;   // enqueue to applied
+        double maxLatencyUs = 0;
+    };
+
+    explicit IngestQueue(GraphStore& store) : IngestQueue(store, Options{}) {}
+    IngestQueue(GraphStore& store, Options opt)
+        : store_(store), opt_(opt), ring_(opt.capacity), started_(Clock::now()) {
+        if (opt_.maxBatch == 0) opt_.maxBatch = 1;
+        applier_ = std::thread([this] { applyLoop(); });
+    }
+
+    ~IngestQueue() { stop(); }
+
+    IngestQueue(const IngestQueue&) = delete;
+    IngestQueue& operator=(const IngestQueue&) = delete;
+
+    // Non-blocking. Returns false if the ring is full or the queue has stopped.
+    bool tryPush(uint64_t src, uint64_t tgt, long long ts) {
+        Producer guard(*this);
+        if (!guard.admitted) return false;
+        if (!ring_.tryPush({ { src, tgt, ts }, now() })) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        enqueued_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    // Waits for room if the ring is full. Returns false only if the queue has stopped.
+    bool push(uint64_t src, uint64_t tgt, long long ts) {
+        Producer guard(*this);
+        if (!guard.admitted) return false;
+        Slot s{ { src, tgt, ts }, now() };
+        uint64_t done = applied_.load(std::memory_order_acquire);
+        if (!ring_.tryPush(s)) {
+            stalls_.fetch_add(1, std::memory_order_relaxed);
+            do {
+                if (stopping_.load()) return false;
+                // The applier is draining the ring (this producer keeps it from
+                // exiting), so applied_ moves once there is room again.
+                applied_.wait(done, std::memory_order_acquire);
+                done = applied_.load(std::memory_order_acquire);
+            } while (!ring_.tryPush(s));
+        }
+        enqueued_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns once every record pushed before the call has reached the store.
+    void flush() {
+        uint64_t target = enqueued_.load(std::memory_order_acquire);
+        for (uint64_t done; (done = applied_.load(std::memory_order_acquire)) < target;)
+            applied_.wait(done, std::memory_order_acquire);
+    }
+
+    // Refuses new records, applies whatever is already queued and joins the applier.
+    void stop() {
+        stopping_.store(true);
+        wake();
+        if (applier_.joinable()) applier_.join();
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.enqueued = enqueued_.load(std::memory_order_relaxed);
+        s.applied = applied_.load(std::memory_order_relaxed);
+        s.rejected = rejected_.load(std::memory_order_relaxed);
+        s.stalls = stalls_.load(std::memory_order_relaxed);
+        s.batches = batches_.load(std::memory_order_relaxed);
+        double secs = std::chrono::duration<double>(Clock::now() - started_).count();
+        if (secs > 0) s.recordsPerSec = s.applied / secs;
+        if (s.applied) s.meanLatencyUs = latency_sum_ns_.load(std::memory_order_relaxed) / 1e3 / s.applied;
+        s.maxLatencyUs = latency_max_ns_.load(std::memory_order_relaxed) / 1e3;
+        return s;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Slot {
+        EdgeRecord rec;
+        int64_t enqueuedNs;
+    };
+
+    // Marks a producer as mid-push. Together with stopping_ (both sequentially
+    // consistent) this tells the applier when no more records can arrive: either
+    // the producer sees stopping_ and backs out, or the applier sees it in flight.
+    // Leaving wakes the applier, both for the record just published and for a
+    // stop that was waiting on this producer.
+    struct Producer {
+        IngestQueue& q;
+        bool admitted;
+        explicit Producer(IngestQueue& queue) : q(queue) {
+            q.in_flight_.fetch_add(1);
+            admitted = !q.stopping_.load();
+        }
+        ~Producer() {
+            q.in_flight_.fetch_sub(1);
+            q.wake();
+        }
+    };
+
+    void wake() {
+        wake_.fetch_add(1);
+        wake_.notify_one();
+    }
+
+    int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started_).count();
+    }
+
+    void applyLoop() {
+        std::vector<Slot> batch;
+        batch.reserve(opt_.maxBatch);
+        for (;;) {
+            batch.clear();
+            // Read before looking at the ring: anything published after this
+            // bumps wake_ past `seen`, so the wait below cannot miss it.
+            uint32_t seen = wake_.load();
+            Slot s;
+            while (batch.size() < opt_.maxBatch && ring_.tryPop(s)) batch.push_back(s);
+            if (batch.empty()) {
+                if (stopping_.load() && in_flight_.load() == 0) {
+                    // Nothing new can be published now; take what is left and exit.
+                    while (ring_.tryPop(s)) batch.push_back(s);
+                    if (!batch.empty()) apply(batch);
+                    return;
+                }
+                wake_.wait(seen);
+                continue;
+            }
+            apply(batch);
+        }
+    }
+
+    void apply(const std::vector<Slot>& batch) {
+        records_.clear();
+        for (const Slot& s : batch) records_.push_back(s.rec);
+        store_.addEdges(records_);
+
+        int64_t t = now(), sum = 0, worst = 0;
+        for (const Slot& s : batch) {
+            int64_t lat = t - s.enqueuedNs;
+            sum += lat;
+            worst = std::max(worst, lat);
+        }
+        latency_sum_ns_.fetch_add(sum, std::memory_order_relaxed);
+        if (worst > latency_max_ns_.load(std::memory_order_relaxed))
+            latency_max_ns_.store(worst, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        applied_.fetch_add(batch.size(), std::memory_order_release);
+        applied_.notify_all();
+    }
+
+    GraphStore& store_;
+    Options opt_;
+    MpscRing<Slot> ring_;
+    std::vector<EdgeRecord> records_;   // applier thread only
+    Clock::time_point started_;
+    std::thread applier_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<unsigned> in_flight_{0};
+    std::atomic<uint32_t> wake_{0};     // bumped by producers and stop(); the idle applier waits on it
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> applied_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> stalls_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<int64_t> latency_sum_ns_{0};
+    std::atomic<int64_t> latency_max_ns_{0};
+};
+
+}
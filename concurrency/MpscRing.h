@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace graph {
+
+// Bounded lock-free queue for many producers and a single consumer. Each cell
+// carries a sequence number that says whose turn it is: a producer claims a
+// position with one CAS on the tail and publishes the value by bumping the
+// cell's sequence, and the consumer reads cells in order without any atomic
+// read-modify-write. Full and empty are both detected from the sequence alone,
+// so neither side ever blocks the other.
+template <typename T>
+class MpscRing {
+public:
+    // Capacity is rounded up to a power of two.
+    explicit MpscRing(size_t capacity) {
+        size_t n = 2;
+        while (n < capacity) n <<= 1;
+        mask_ = n - 1;
+        cells_.reset(new Cell[n]);
+        for (size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Safe from any thread. Returns false if the ring is full.
+    bool tryPush(const T& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells_[pos & mask_];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = value;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. Returns false if nothing has been published yet.
+    bool tryPop(T& out) {
+        Cell& c = cells_[head_ & mask_];
+        size_t seq = c.seq.load(std::memory_order_acquire);
+        if (seq != head_ + 1) return false;
+        out = c.value;
+        c.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    size_t mask_ = 0;
+    std::unique_ptr<Cell[]> cells_;
+    // Producers and the consumer touch opposite ends; keep them on separate lines.
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) size_t head_ = 0;
+};
+
+}
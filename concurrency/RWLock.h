@@ -3,16 +3,27 @@
 #include <mutex>
 
 namespace graph {
+// Reader-writer lock that does not starve writers. std::shared_mutex makes no
+// fairness promise (glibc prefers readers), so a steady stream of queries could
+// hold off ingest forever. A writer holds the turnstile while it waits, which
+// stops new readers from slipping in ahead of it.
 class RWLock {
 public:
     RWLock() = default;
     RWLock(const RWLock&) = delete;
     RWLock& operator=(const RWLock&) = delete;
 
-    auto read() const { return std::shared_lock(mutex_); }
-    auto write() { return std::unique_lock(mutex_); }
+    auto read() const {
+        std::lock_guard<std::mutex> gate(turnstile_);
+        return std::shared_lock(mutex_);
+    }
+    auto write() {
+        std::lock_guard<std::mutex> gate(turnstile_);
+        return std::unique_lock(mutex_);
+    }
 
 private:
+    mutable std::mutex turnstile_;
     mutable std::shared_mutex mutex_;
 };
 }
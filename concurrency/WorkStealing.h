@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+
+namespace graph {
+
+// Parallel loop over [0, n) for skewed workloads (e.g. per-vertex graph scans where a
+// few hubs cost far more than the rest). Each worker starts with a contiguous slice
+// and takes `grain` items at a time from its front; when it runs dry it steals the
+// back half of the largest remaining slice. fn(begin, end, worker) is called for each
+// chunk; worker is in [0, threads) so callers can keep per-worker accumulators.
+class WorkStealing {
+public:
+    static unsigned defaultThreads() {
+        unsigned hc = std::thread::hardware_concurrency();
+        return hc ? hc : 1;
+    }
+
+    template <typename Fn>
+    static void run(size_t n, unsigned threads, size_t grain, Fn&& fn) {
+        if (n == 0) return;
+        if (threads == 0) threads = defaultThreads();
+        threads = static_cast<unsigned>(std::min<size_t>(threads, n));
+        if (grain == 0) grain = 1;
+        if (threads <= 1) {
+            for (size_t b = 0; b < n; b += grain) fn(b, std::min(n, b + grain), 0u);
+            return;
+        }
+
+        std::unique_ptr<Slice[]> slices(new Slice[threads]);
+        for (unsigned w = 0; w < threads; ++w) {
+            slices[w].begin = n * w / threads;
+            slices[w].end = n * (w + 1) / threads;
+        }
+
+        auto worker = [&](unsigned w) {
+            size_t b, e;
+            while (true) {
+                if (slices[w].take(grain, b, e)) { fn(b, e, w); continue; }
+                if (!steal(slices.get(), threads, w)) return;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned w = 1; w < threads; ++w) pool.emplace_back(worker, w);
+        worker(0);
+        for (auto& t : pool) t.join();
+    }
+
+private:
+    struct alignas(64) Slice {
+        std::mutex m;
+        size_t begin = 0, end = 0;
+
+        bool take(size_t grain, size_t& b, size_t& e) {
+            std::lock_guard<std::mutex> lock(m);
+            if (begin >= end) return false;
+            b = begin;
+            e = std::min(end, begin + grain);
+            begin = e;
+            return true;
+        }
+    };
+
+    // Moves the back half of the fullest other slice into slices[self].
+    static bool steal(Slice* slices, unsigned threads, unsigned self) {
+        while (true) {
+            unsigned victim = threads;
+            size_t best = 0;
+            for (unsigned v = 0; v < threads; ++v) {
+                if (v == self) continue;
+                std::lock_guard<std::mutex> lock(slices[v].m);
+                size_t left = slices[v].end - slices[v].begin;
+                if (left > best) { best = left; victim = v; }
+            }
+            if (victim == threads) return false;
+
+            std::scoped_lock lock(slices[self].m, slices[victim].m);
+            Slice& vs = slices[victim];
+            if (vs.begin >= vs.end) continue; // drained while we looked; rescan
+            size_t mid = vs.begin + (vs.end - vs.begin) / 2; // a lone item moves whole
+            slices[self].begin = mid;
+            slices[self].end = vs.end;
+            vs.end = mid;
+            return true;
+        }
+    }
+};
+
+}
@@ -0,0 +1,120 @@
+#ifndef CSR_SNAPSHOT_H
+#define CSR_SNAPSHOT_H
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+
+namespace graph {
+
+// Immutable compressed-sparse-row view of the graph at one store version.
+// Nodes are renumbered densely (0..n-1) in ascending ID order. Three layouts are kept:
+//  - incidence: one slot per edge endpoint, each node's run sorted by time
+//  - adjacency: distinct neighbors per node, sorted by dense index
+//  - stream:    every edge once, in chronological order, for single-pass sweeps
+class CsrSnapshot {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    // `forEachEdge(fn)` must call fn(src, tgt, ts) for every edge in chronological order.
+    template <typename ForEachEdge>
+    CsrSnapshot(uint64_t version, std::vector<uint64_t> nodeIds, ForEachEdge&& forEachEdge)
+        : version_(version), ids_(std::move(nodeIds)) {
+        forEachEdge([&](uint64_t s, uint64_t t, long long) {
+            ids_.push_back(s);
+            ids_.push_back(t);
+            ++edge_count_;
+        });
+        std::sort(ids_.begin(), ids_.end());
+        ids_.erase(std::unique(ids_.begin(), ids_.end()), ids_.end());
+        ids_.shrink_to_fit();
+
+        // Counting pass, then a stable fill so each node's run stays chronological.
+        const size_t n = ids_.size();
+        inc_off_.assign(n + 1, 0);
+        forEachEdge([&](uint64_t s, uint64_t t, long long) {
+            ++inc_off_[indexOf(s) + 1];
+            if (t != s) ++inc_off_[indexOf(t) + 1];
+        });
+        for (size_t i = 0; i < n; ++i) inc_off_[i + 1] += inc_off_[i];
+
+        inc_nbr_.resize(inc_off_[n]);
+        inc_ts_.resize(inc_off_[n]);
+        stream_src_.reserve(edge_count_);
+        stream_tgt_.reserve(edge_count_);
+        stream_ts_.reserve(edge_count_);
+        std::vector<uint64_t> cursor(inc_off_.begin(), inc_off_.end() - 1);
+        forEachEdge([&](uint64_t s, uint64_t t, long long ts) {
+            uint32_t a = indexOf(s), b = indexOf(t);
+            inc_nbr_[cursor[a]] = b; inc_ts_[cursor[a]++] = ts;
+            if (b != a) { inc_nbr_[cursor[b]] = a; inc_ts_[cursor[b]++] = ts; }
+            stream_src_.push_back(a);
+            stream_tgt_.push_back(b);
+            stream_ts_.push_back(ts);
+        });
+
+        adj_off_.assign(n + 1, 0);
+        adj_.reserve(inc_nbr_.size());
+        std::vector<uint32_t> scratch;
+        for (size_t v = 0; v < n; ++v) {
+            scratch.assign(inc_nbr_.begin() + inc_off_[v], inc_nbr_.begin() + inc_off_[v + 1]);
+            std::sort(scratch.begin(), scratch.end());
+            scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+            adj_.insert(adj_.end(), scratch.begin(), scratch.end());
+            adj_off_[v + 1] = adj_.size();
+        }
+        adj_.shrink_to_fit();
+    }
+
+    uint64_t version() const { return version_; }
+    size_t nodeCount() const { return ids_.size(); }
+    size_t edgeCount() const { return edge_count_; }
+
+    uint64_t idOf(uint32_t v) const { return ids_[v]; }
+    uint32_t indexOf(uint64_t id) const {
+        auto it = std::lower_bound(ids_.begin(), ids_.end(), id);
+        return (it != ids_.end() && *it == id) ? static_cast<uint32_t>(it - ids_.begin()) : npos;
+    }
+
+    // Number of edges touching v (self-loops count once).
+    uint32_t degree(uint32_t v) const { return static_cast<uint32_t>(inc_off_[v + 1] - inc_off_[v]); }
+    std::span<const uint32_t> incidentNeighbors(uint32_t v) const {
+        return { inc_nbr_.data() + inc_off_[v], inc_nbr_.data() + inc_off_[v + 1] };
+    }
+    std::span<const long long> incidentTimes(uint32_t v) const {
+        return { inc_ts_.data() + inc_off_[v], inc_ts_.data() + inc_off_[v + 1] };
+    }
+    // Position of v's run in the flat incidence arrays, for per-slot side tables.
+    size_t incidenceBegin(uint32_t v) const { return inc_off_[v]; }
+
+    // Distinct neighbors of v, ascending.
+    std::span<const uint32_t> neighbors(uint32_t v) const {
+        return { adj_.data() + adj_off_[v], adj_.data() + adj_off_[v + 1] };
+    }
+    bool adjacent(uint32_t u, uint32_t v) const {
+        auto n = neighbors(u);
+        return std::binary_search(n.begin(), n.end(), v);
+    }
+
+    // Edge stream columns, oldest first (ties in insertion order). Index i is the
+    // i-th edge in time; endpoints are dense indices.
+    std::span<const uint32_t> streamSources() const { return stream_src_; }
+    std::span<const uint32_t> streamTargets() const { return stream_tgt_; }
+    std::span<const long long> streamTimes() const { return stream_ts_; }
+
+private:
+    uint64_t version_;
+    size_t edge_count_ = 0;
+    std::vector<uint64_t> ids_;
+    std::vector<uint64_t> inc_off_;
+    std::vector<uint32_t> inc_nbr_;
+    std::vector<long long> inc_ts_;
+    std::vector<uint64_t> adj_off_;
+    std::vector<uint32_t> adj_;
+    std::vector<uint32_t> stream_src_;
+    std::vector<uint32_t> stream_tgt_;
+    std::vector<long long> stream_ts_;
+};
+
+}
+#endif
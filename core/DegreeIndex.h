@@ -0,0 +1,193 @@
+#ifndef DEGREE_INDEX_H
+#define DEGREE_INDEX_H
+#include <vector>
+#include <set>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include "core/EdgeLog.h"
+
+namespace graph {
+
+// Per-node degree counters kept up to date as edges are added and removed, plus an
+// ordered view per metric so top-k is a walk off the end of a tree instead of a
+// scan over the graph.
+//  - Total:    edges touching the node (self-loops once)
+//  - Distinct: different counterparts the node has a live edge with
+//  - Windowed: edges within `window` seconds of the newest timestamp seen
+// The owner tells the index when a pair gains its first / loses its last edge.
+class DegreeIndex {
+public:
+    enum class Metric { Total, Distinct, Windowed };
+    struct Counts { uint32_t total = 0, distinct = 0, windowed = 0; };
+
+    static constexpr long long kDefaultWindow = 30LL * 24 * 3600;
+
+    explicit DegreeIndex(const EdgeLog& log) : log_(log) {}
+
+    void addNode(uint64_t id) { entry(id); }
+
+    void addEdge(EdgeId e, bool firstOfPair) {
+        uint64_t s = log_.source(e), t = log_.target(e);
+        long long ts = log_.timestamp(e);
+        bump(s, &Counts::total, +1);
+        if (t != s) bump(t, &Counts::total, +1);
+        if (firstOfPair) {
+            bump(s, &Counts::distinct, +1);
+            if (t != s) bump(t, &Counts::distinct, +1);
+        }
+        if (ts > newest_) {
+            newest_ = ts;
+            expire();
+        }
+        if (inWindow(ts)) {
+            window_heap_.push({ ts, e });
+            bump(s, &Counts::windowed, +1);
+            if (t != s) bump(t, &Counts::windowed, +1);
+        }
+    }
+
+    // Same end state as calling addEdge for each (edge, firstOfPair) in turn, but
+    // each touched node is re-keyed once per metric rather than once per edge.
+    void addEdges(const std::vector<std::pair<EdgeId, bool>>& batch) {
+        if (batch.empty()) return;
+        long long newest = newest_;
+        for (auto const& [e, first] : batch) newest = std::max(newest, log_.timestamp(e));
+        if (newest > newest_) {
+            newest_ = newest;
+            expire();
+        }
+
+        std::unordered_map<uint64_t, Counts> delta;
+        for (auto const& [e, first] : batch) {
+            uint64_t s = log_.source(e), t = log_.target(e);
+            long long ts = log_.timestamp(e);
+            bool windowed = inWindow(ts);
+            if (windowed) window_heap_.push({ ts, e });
+            for (uint64_t id : { s, t }) {
+                Counts& d = delta[id];
+                ++d.total;
+                if (first) ++d.distinct;
+                if (windowed) ++d.windowed;
+                if (t == s) break;
+            }
+        }
+        for (auto const& [id, d] : delta) {
+            Counts c = entry(id);
+            if (d.total) set(id, &Counts::total, c.total + d.total);
+            if (d.distinct) set(id, &Counts::distinct, c.distinct + d.distinct);
+            if (d.windowed) set(id, &Counts::windowed, c.windowed + d.windowed);
+        }
+    }
+
+    // Call before the edge is tombstoned in the log.
+    void removeEdge(EdgeId e, bool lastOfPair) {
+        uint64_t s = log_.source(e), t = log_.target(e);
+        bump(s, &Counts::total, -1);
+        if (t != s) bump(t, &Counts::total, -1);
+        if (lastOfPair) {
+            bump(s, &Counts::distinct, -1);
+            if (t != s) bump(t, &Counts::distinct, -1);
+        }
+        // Still in the heap; expire() skips it later because the log marks it dead.
+        if (inWindow(log_.timestamp(e))) {
+            bump(s, &Counts::windowed, -1);
+            if (t != s) bump(t, &Counts::windowed, -1);
+        }
+    }
+
+    // Changes the window length and recounts from `liveEdges` (any order).
+    void setWindow(long long seconds, const std::vector<EdgeId>& liveEdges) {
+        window_ = seconds;
+        window_heap_ = {};
+        for (auto& [id, c] : counts_) if (c.windowed) set(id, &Counts::windowed, 0);
+        for (EdgeId e : liveEdges) {
+            long long ts = log_.timestamp(e);
+            if (!inWindow(ts)) continue;
+            window_heap_.push({ ts, e });
+            uint64_t s = log_.source(e), t = log_.target(e);
+            bump(s, &Counts::windowed, +1);
+            if (t != s) bump(t, &Counts::windowed, +1);
+        }
+    }
+    long long window() const { return window_; }
+
+    void clear() {
+        counts_.clear();
+        for (auto& o : order_) o.clear();
+        window_heap_ = {};
+        newest_ = LLONG_MIN;
+    }
+
+    Counts counts(uint64_t id) const {
+        auto it = counts_.find(id);
+        return (it == counts_.end()) ? Counts{} : it->second;
+    }
+
+    // Up to k (node, count) pairs, highest first; ties go to the higher node ID.
+    std::vector<std::pair<uint64_t, uint32_t>> top(Metric m, size_t k) const {
+        std::vector<std::pair<uint64_t, uint32_t>> out;
+        auto const& o = order_[static_cast<int>(m)];
+        for (auto it = o.rbegin(); it != o.rend() && out.size() < k; ++it)
+            out.push_back({ it->second, it->first });
+        return out;
+    }
+
+private:
+    using Field = uint32_t Counts::*;
+
+    Counts& entry(uint64_t id) {
+        auto [it, fresh] = counts_.try_emplace(id);
+        if (fresh) for (auto& o : order_) o.insert({ 0, id });
+        return it->second;
+    }
+
+    static int metricOf(Field f) {
+        return f == &Counts::total ? 0 : f == &Counts::distinct ? 1 : 2;
+    }
+
+    void set(uint64_t id, Field f, uint32_t value) {
+        Counts& c = entry(id);
+        auto& o = order_[metricOf(f)];
+        // Re-key the existing tree node in place: no allocation on the ingest path.
+        auto nh = o.extract({ c.*f, id });
+        nh.value().first = value;
+        o.insert(std::move(nh));
+        c.*f = value;
+    }
+
+    void bump(uint64_t id, Field f, int delta) {
+        set(id, f, entry(id).*f + delta);
+    }
+
+    bool inWindow(long long ts) const {
+        return newest_ == LLONG_MIN || ts >= newest_ - window_;
+    }
+
+    // Drops edges that fell out of the window after newest_ advanced.
+    void expire() {
+        while (!window_heap_.empty() && !inWindow(window_heap_.top().first)) {
+            EdgeId e = window_heap_.top().second;
+            window_heap_.pop();
+            if (!log_.alive(e)) continue;
+            uint64_t s = log_.source(e), t = log_.target(e);
+            bump(s, &Counts::windowed, -1);
+            if (t != s) bump(t, &Counts::windowed, -1);
+        }
+    }
+
+    const EdgeLog& log_;
+    long long window_ = kDefaultWindow;
+    long long newest_ = LLONG_MIN;
+    std::unordered_map<uint64_t, Counts> counts_;
+    std::set<std::pair<uint32_t, uint64_t>> order_[3];
+    std::priority_queue<std::pair<long long, EdgeId>, std::vector<std::pair<long long, EdgeId>>,
+                        std::greater<>> window_heap_;
+};
+
+}
+#endif
@@ -0,0 +1,141 @@
+#ifndef EDGE_LOG_H
+#define EDGE_LOG_H
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include "core/Edge.h"
+
+namespace graph {
+
+using EdgeId = uint64_t;
+
+// One interaction as it arrives from outside, before it has an EdgeId.
+struct EdgeRecord {
+    uint64_t source;
+    uint64_t target;
+    long long timestamp;
+};
+
+// Append-only columnar edge storage. Edges live in fixed-size segments of
+// source/target/timestamp columns, so an append is three stores into the open
+// segment and only allocates once every kSegmentSize edges. Existing edges never
+// move, which keeps EdgeIds stable for the lifetime of the log. Removal is a
+// tombstone stamped with the epoch it happened in; the slot is kept so IDs
+// don't shift.
+//
+// Because slots are written once and tombstones only ever go from "live" to an
+// epoch, a View (shared segment pointers, the size and the epoch at the time it
+// was taken) can be read without any lock while the log keeps growing. Segments
+// are reference counted, so ones dropped by clear() are freed once the last
+// View that pins them goes away.
+class EdgeLog {
+    struct Segment;
+public:
+    static constexpr size_t kSegmentBits = 14;
+    static constexpr size_t kSegmentSize = size_t(1) << kSegmentBits;
+    static constexpr uint64_t kLive = UINT64_MAX;
+
+    class View {
+    public:
+        View() = default;
+
+        uint64_t epoch() const { return epoch_; }
+        // Slots visible to this view; IDs at or past this were appended later.
+        size_t size() const { return size_; }
+
+        // True if the edge existed and had not been removed as of the view's epoch.
+        bool visible(EdgeId id) const {
+            if (id >= size_) return false;
+            std::atomic_ref<uint64_t> r(segments_[id >> kSegmentBits]->removed_at[slot(id)]);
+            return r.load(std::memory_order_relaxed) > epoch_;
+        }
+        uint64_t source(EdgeId id) const { return seg(id).source[slot(id)]; }
+        uint64_t target(EdgeId id) const { return seg(id).target[slot(id)]; }
+        long long timestamp(EdgeId id) const { return seg(id).timestamp[slot(id)]; }
+
+    private:
+        friend class EdgeLog;
+        View(std::vector<std::shared_ptr<Segment>> segs, size_t size, uint64_t epoch)
+            : segments_(std::move(segs)), size_(size), epoch_(epoch) {}
+        const Segment& seg(EdgeId id) const { return *segments_[id >> kSegmentBits]; }
+
+        std::vector<std::shared_ptr<Segment>> segments_;
+        size_t size_ = 0;
+        uint64_t epoch_ = 0;
+    };
+
+    EdgeId append(uint64_t src, uint64_t tgt, long long ts) {
+        size_t slot = size_ & (kSegmentSize - 1);
+        if (slot == 0) segments_.push_back(std::shared_ptr<Segment>(new Segment)); // left uninitialised
+        Segment& seg = *segments_.back();
+        seg.source[slot] = src;
+        seg.target[slot] = tgt;
+        seg.timestamp[slot] = ts;
+        seg.removed_at[slot] = kLive;
+        ++live_;
+        return size_++;
+    }
+
+    // Tombstones an edge as of `epoch`: views taken at an earlier epoch still see
+    // it. Returns false if it was already removed.
+    bool remove(EdgeId id, uint64_t epoch) {
+        std::atomic_ref<uint64_t> r(seg(id).removed_at[slot(id)]);
+        if (r.load(std::memory_order_relaxed) != kLive) return false;
+        r.store(epoch, std::memory_order_relaxed);
+        --live_;
+        return true;
+    }
+
+    // Makes room in the segment table for `edges` slots in total.
+    void reserve(size_t edges) {
+        segments_.reserve((edges + kSegmentSize - 1) >> kSegmentBits);
+    }
+
+    void clear() {
+        segments_.clear();
+        size_ = 0;
+        live_ = 0;
+    }
+
+    // Total slots ever appended (including tombstones); valid IDs are [0, size()).
+    size_t size() const { return size_; }
+    // Edges that have not been removed.
+    size_t liveCount() const { return live_; }
+
+    uint64_t source(EdgeId id) const { return seg(id).source[slot(id)]; }
+    uint64_t target(EdgeId id) const { return seg(id).target[slot(id)]; }
+    long long timestamp(EdgeId id) const { return seg(id).timestamp[slot(id)]; }
+    bool alive(EdgeId id) const { return seg(id).removed_at[slot(id)] == kLive; }
+    Edge edge(EdgeId id) const {
+        const Segment& s = seg(id);
+        size_t i = slot(id);
+        return Edge(s.source[i], s.target[i], s.timestamp[i]);
+    }
+
+    // Read-only view of the log as it stands now, at `epoch`. The caller must
+    // exclude writers while taking it; reading it afterwards needs no lock.
+    View view(uint64_t epoch) const {
+        return View(segments_, size_, epoch);
+    }
+
+private:
+    struct Segment {
+        uint64_t source[kSegmentSize];
+        uint64_t target[kSegmentSize];
+        long long timestamp[kSegmentSize];
+        uint64_t removed_at[kSegmentSize];   // kLive, or the epoch it was removed in
+    };
+
+    static size_t slot(EdgeId id) { return id & (kSegmentSize - 1); }
+    Segment& seg(EdgeId id) { return *segments_[id >> kSegmentBits]; }
+    const Segment& seg(EdgeId id) const { return *segments_[id >> kSegmentBits]; }
+
+    std::vector<std::shared_ptr<Segment>> segments_;
+    size_t size_ = 0;
+    size_t live_ = 0;
+};
+
+}
+#endif
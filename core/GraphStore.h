@@ -1,6 +1,5 @@
 #ifndef GRAPH_STORE_H
 #define GRAPH_STORE_H
-#include "concurrency/RWLock.h"
 #include <vector>
 #include <unordered_map>
 #include <map>
@@ -9,90 +8,559 @@
 #include <string>
 #include "core/Node.h"
 #include "core/Edge.h"
+#include "core/EdgeLog.h"
+#include "core/TimeIndex.h"
+#include "core/DegreeIndex.h"
+#include "core/CsrSnapshot.h"
+#include "core/GraphView.h"
+#include "core/MutationListener.h"
 #include "concurrency/RWLock.h"
+#include "analytics/SortedIntersect.h"
 #include <unordered_set>
 #include <algorithm>
+#include <iterator>
+#include <atomic>
+#include <optional>
+#include <span>
 
 namespace graph {
 
+// Thread-safe: any number of readers run concurrently under shared locks while
+// writers take the locks exclusively. Node and edge state have separate locks,
+// always acquired edges first, so edge visitors may look up node labels.
 class GraphStore {
 public:
     uint64_t addNode(std::string label) {
-        std::lock_guard<std::mutex> lock(nodes_mutex_);
+        auto elock = edges_lock_.write();
+        auto nlock = nodes_lock_.write();
         uint64_t id = next_node_id_++;
         nodes_[id] = std::make_unique<Node>(id, label);
+        degrees_.addNode(id);
+        uint64_t v = ++version_;
+        if (listener_) listener_->nodesAdded(id, std::span<const std::string>(&label, 1), {}, v);
         return id;
     }
 
-    void addEdge(uint64_t src, uint64_t tgt, long long ts) {
-        std::lock_guard<std::mutex> lock(edges_mutex_);
-        // FIXED: Removed the extra ID argument to match Edge.h
-        auto edge = std::make_shared<Edge>(src, tgt, ts);
-        timeline_[ts].push_back(edge);
+    // Adds one node per label under a single lock and one version bump. IDs are
+    // consecutive; returns the first. `images`, if given, runs parallel to
+    // `labels`; "" keeps the default image.
+    uint64_t addNodes(std::span<const std::string> labels, std::span<const std::string> images = {}) {
+        auto elock = edges_lock_.write();
+        auto nlock = nodes_lock_.write();
+        uint64_t first = next_node_id_;
+        nodes_.reserve(nodes_.size() + labels.size());
+        for (size_t i = 0; i < labels.size(); ++i) {
+            uint64_t id = next_node_id_++;
+            nodes_[id] = makeNode(id, labels[i], images, i);
+            degrees_.addNode(id);
+        }
+        uint64_t v = ++version_;
+        if (listener_) listener_->nodesAdded(first, labels, hasImages(images) ? images : std::span<const std::string>(), v);
+        return first;
     }
 
-    std::unordered_map<uint64_t, std::unique_ptr<Node>>& getNodes() { return nodes_; }
-    std::map<long long, std::vector<std::shared_ptr<Edge>>>& getChronologicalEdges() { return timeline_; }
-    
-    std::string getNodeLabel(uint64_t id) {
-        if (nodes_.count(id)) return nodes_[id]->label();
-        return "Unknown";
+    // Recreates nodes under known IDs, for recovery. IDs already present are left
+    // alone; later addNode calls continue past the highest ID restored.
+    void restoreNodes(std::span<const uint64_t> ids, std::span<const std::string> labels,
+                      std::span<const std::string> images = {}) {
+        auto elock = edges_lock_.write();
+        auto nlock = nodes_lock_.write();
+        uint64_t v = ++version_;
+        nodes_.reserve(nodes_.size() + ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            auto [it, fresh] = nodes_.try_emplace(ids[i]);
+            if (!fresh) continue;
+            it->second = makeNode(ids[i], labels[i], images, i);
+            degrees_.addNode(ids[i]);
+            next_node_id_ = std::max(next_node_id_, ids[i] + 1);
+            if (listener_)
+                listener_->nodesAdded(ids[i], labels.subspan(i, 1), images.empty() ? images : images.subspan(i, 1), v);
+        }
     }
-    // --- Helper query methods used by CommandHandler / Investigation ---
-    // Return a vector of neighbors (unique node IDs) for a given node.
-    std::vector<uint64_t> getNeighbors(uint64_t id) {
-        std::lock_guard<std::mutex> lock(edges_mutex_);
-        std::unordered_set<uint64_t> s;
-        for (auto const& [ts, list] : timeline_) {
-            for (auto const& e : list) {
-                if (e->source() == id) s.insert(e->target());
-                else if (e->target() == id) s.insert(e->source());
+
+    // Returns false if the node does not exist. The image is kept.
+    bool renameNode(uint64_t id, std::string label) {
+        auto lock = nodes_lock_.write();
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) return false;
+        it->second->setLabel(std::move(label));
+        uint64_t v = ++version_;
+        if (listener_) listener_->nodeRenamed(id, it->second->label(), v);
+        return true;
+    }
+
+    // Returns false if the node does not exist.
+    bool setNodeImage(uint64_t id, std::string path) {
+        auto lock = nodes_lock_.write();
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) return false;
+        it->second->setImage(std::move(path));
+        uint64_t v = ++version_;
+        if (listener_) listener_->nodeImageSet(id, it->second->image(), v);
+        return true;
+    }
+
+    EdgeId addEdge(uint64_t src, uint64_t tgt, long long ts) {
+        auto lock = edges_lock_.write();
+        EdgeId e = log_.append(src, tgt, ts);
+        indexTime(e);
+        indexEdge(src, e);
+        if (tgt != src) indexEdge(tgt, e);
+        auto& history = pairs_[pairKey(src, tgt)];
+        insertByTime(history, e);
+        if (history.size() == 1) linkNeighbors(src, tgt);
+        degrees_.addEdge(e, history.size() == 1);
+        uint64_t v = ++version_;
+        if (listener_) {
+            EdgeRecord r{ src, tgt, ts };
+            listener_->edgesAdded(std::span<const EdgeRecord>(&r, 1), v);
+        }
+        return e;
+    }
+
+    // Bulk form of addEdge, for loads and ingest batches. The batch is appended to
+    // the log under one lock, sorted by time once, and merged into the timeline in
+    // a single pass. Per-node and per-pair lists get their new entries appended in
+    // time order, so a list only needs a merge if the batch reaches back before
+    // its last entry. EdgeIds are consecutive in batch order; returns the first.
+    EdgeId addEdges(std::span<const EdgeRecord> batch) {
+        auto lock = edges_lock_.write();
+        EdgeId first = log_.size();
+        if (batch.empty()) return first;
+        log_.reserve(log_.size() + batch.size());
+        for (auto const& r : batch) log_.append(r.source, r.target, r.timestamp);
+
+        std::vector<EdgeId> order(batch.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = first + i;
+        auto earlier = [this](EdgeId a, EdgeId b) { return log_.timestamp(a) < log_.timestamp(b); };
+        if (!std::is_sorted(order.begin(), order.end(), earlier))
+            std::stable_sort(order.begin(), order.end(), earlier);
+        by_time_.merge(order, [this](EdgeId e) { return log_.timestamp(e); });
+
+        pairs_.reserve(pairs_.size() + batch.size());
+        std::vector<std::pair<std::vector<EdgeId>*, size_t>> unsorted;
+        auto append = [&](std::vector<EdgeId>& list, EdgeId e) {
+            // New entries arrive in time order, so only the seam with the old ones can be out of order.
+            if (!list.empty() && log_.timestamp(list.back()) > log_.timestamp(e)) unsorted.push_back({ &list, list.size() });
+            list.push_back(e);
+        };
+        std::vector<std::pair<EdgeId, bool>> degreeBatch;
+        degreeBatch.reserve(order.size());
+        // Neighbor lists touched by the batch, with where their new entries start.
+        std::unordered_map<std::vector<uint64_t>*, size_t> grown;
+        auto link = [&](uint64_t id, uint64_t other) {
+            auto& list = neighbors_[id];
+            grown.try_emplace(&list, list.size());
+            list.push_back(other);
+        };
+        for (EdgeId e : order) {
+            uint64_t s = log_.source(e), t = log_.target(e);
+            append(incidence_[s], e);
+            if (t != s) append(incidence_[t], e);
+            auto& history = pairs_[pairKey(s, t)];
+            degreeBatch.push_back({ e, history.empty() });
+            if (history.empty()) {
+                link(s, t);
+                if (t != s) link(t, s);
             }
+            append(history, e);
+        }
+        for (auto [list, seam] : unsorted)
+            std::inplace_merge(list->begin(), list->begin() + seam, list->end(), earlier);
+        for (auto [list, seam] : grown) {
+            std::sort(list->begin() + seam, list->end());
+            std::inplace_merge(list->begin(), list->begin() + seam, list->end());
         }
-        return std::vector<uint64_t>(s.begin(), s.end());
+        degrees_.addEdges(degreeBatch);
+        uint64_t v = ++version_;
+        if (listener_) listener_->edgesAdded(batch, v);
+        return first;
     }
 
-    // Return common neighbors (intersection) of a and b.
-    std::vector<uint64_t> getCommonNeighbors(uint64_t a, uint64_t b) {
-        auto na = getNeighbors(a);
-        auto nb = getNeighbors(b);
-        std::unordered_set<uint64_t> setA(na.begin(), na.end());
-        std::vector<uint64_t> common;
-        for (auto x : nb) if (setA.count(x)) common.push_back(x);
-        return common;
+    // Removes every edge touching `id` from the timeline and the incidence index.
+    // Returns the number of edges removed.
+    size_t isolateNode(uint64_t id) {
+        auto lock = edges_lock_.write();
+        auto it = incidence_.find(id);
+        if (it == incidence_.end()) return 0;
+        std::vector<EdgeId> removed = std::move(it->second);
+        incidence_.erase(it);
+        neighbors_.erase(id);
+        // Views pinned before this call keep seeing the removed edges.
+        uint64_t epoch = ++version_;
+
+        for (EdgeId e : removed) {
+            uint64_t s = log_.source(e), t = log_.target(e);
+            uint64_t other = (s == id) ? t : s;
+            if (other != id) unindexEdge(other, e);
+            auto pc = pairs_.find(pairKey(s, t));
+            auto& history = pc->second;
+            history.erase(std::find(history.begin(), history.end(), e));
+            bool last = history.empty();
+            if (last) {
+                pairs_.erase(pc);
+                if (other != id) unlinkNeighbor(other, id);
+            }
+            degrees_.removeEdge(e, last);
+            log_.remove(e, epoch);
+        }
+        by_time_.eraseIf([this](EdgeId e) { return !log_.alive(e); });
+        if (listener_) listener_->nodeIsolated(id, epoch);
+        return removed.size();
     }
 
-    // Return all timestamps where there exists an edge between u and v (either direction).
-    std::vector<long long> getAllTimestamps(uint64_t u, uint64_t v) {
-        std::lock_guard<std::mutex> lock(edges_mutex_);
-        std::vector<long long> ts;
-        for (auto const& [t, list] : timeline_) {
-            for (auto const& e : list) {
-                if ((e->source() == u && e->target() == v) || (e->source() == v && e->target() == u)) {
-                    ts.push_back(t);
-                }
+    // Wipes nodes, edges and indexes. Node IDs keep counting up so stale IDs never alias.
+    void clear() {
+        auto elock = edges_lock_.write();
+        auto nlock = nodes_lock_.write();
+        nodes_.clear();
+        log_.clear();
+        by_time_.clear();
+        incidence_.clear();
+        pairs_.clear();
+        neighbors_.clear();
+        degrees_.clear();
+        uint64_t v = ++version_;
+        if (listener_) listener_->cleared(v);
+    }
+
+    // Bumped on every mutation, labels and images included.
+    uint64_t version() const { return version_.load(); }
+
+    // Moves the version forward to at least `v`, so a recovered store carries on
+    // numbering from where the journal it was rebuilt from left off.
+    void advanceVersion(uint64_t v) {
+        auto elock = edges_lock_.write();
+        auto nlock = nodes_lock_.write();
+        if (version_.load() < v) version_.store(v);
+    }
+
+    // Reports every later mutation to `listener` (nullptr detaches). The store
+    // does not own it; detach before destroying it.
+    void setListener(MutationListener* listener) {
+        auto elock = edges_lock_.write();
+        auto nlock = nodes_lock_.write();
+        listener_ = listener;
+    }
+
+    // Pins the current version. The locks are held only long enough to copy the
+    // node IDs and the edge log's segment table; the view is then read lock-free
+    // while writers carry on, and sees exactly the graph as it was here.
+    // withNodeData also copies labels and images, for checkpoints.
+    GraphView pin(bool withNodeData = false) const {
+        auto elock = edges_lock_.read();
+        auto nlock = nodes_lock_.read();
+        std::vector<uint64_t> ids;
+        std::vector<std::string> labels, images;
+        ids.reserve(nodes_.size());
+        for (auto const& [id, n] : nodes_) ids.push_back(id);
+        if (withNodeData) {
+            labels.reserve(nodes_.size());
+            images.reserve(nodes_.size());
+            for (auto const& [id, n] : nodes_) {
+                labels.push_back(n->label());
+                images.push_back(n->image());
             }
         }
-        std::sort(ts.begin(), ts.end());
-        return ts;
+        uint64_t v = version_.load();
+        return GraphView(v, std::move(ids), log_.view(v), log_.liveCount(), std::move(labels), std::move(images));
+    }
+
+    // Returns a read-only CSR view of the current graph. The view is cached and only
+    // rebuilt when the store's version has moved on, so analytics can share it freely.
+    // Builds read from a pinned GraphView, so ingest is never blocked behind one.
+    std::shared_ptr<const CsrSnapshot> freeze() {
+        std::lock_guard<std::mutex> cache(frozen_mutex_);
+        if (frozen_ && frozen_->version() == version_.load()) return frozen_;
+
+        GraphView view = pin();
+        if (frozen_ && frozen_->version() == view.version()) return frozen_;
+        frozen_ = std::make_shared<const CsrSnapshot>(view.version(), view.nodeIds(), [&view](auto&& fn) {
+            view.forEachEdge(fn);
+        });
+        return frozen_;
+    }
+
+    // --- Node read view ---
+    size_t nodeCount() const {
+        auto lock = nodes_lock_.read();
+        return nodes_.size();
+    }
+
+    bool hasNode(uint64_t id) const {
+        auto lock = nodes_lock_.read();
+        return nodes_.count(id) != 0;
+    }
+
+    // A copy of the node, so it stays valid whatever writers do next.
+    std::optional<Node> getNode(uint64_t id) const {
+        auto lock = nodes_lock_.read();
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) return std::nullopt;
+        return *it->second;
+    }
+
+    // Calls fn(const Node&) for every node under a shared lock. fn must not
+    // mutate the store.
+    template <typename Fn>
+    void forEachNode(Fn&& fn) const {
+        auto lock = nodes_lock_.read();
+        for (auto const& [id, n] : nodes_) fn(*n);
+    }
+
+    std::string getNodeLabel(uint64_t id) const {
+        auto lock = nodes_lock_.read();
+        auto it = nodes_.find(id);
+        return (it == nodes_.end()) ? "Unknown" : it->second->label();
+    }
+
+    // --- Edge read view ---
+    // Number of live edges.
+    size_t edgeCount() const {
+        auto lock = edges_lock_.read();
+        return log_.liveCount();
+    }
+
+    // Calls fn(const Edge&) for every live edge, oldest first (ties in insertion order).
+    // A shared edge lock is held throughout, so fn may read node data but must not
+    // call back into edge queries or mutate the store.
+    template <typename Fn>
+    void forEachEdge(Fn&& fn) const {
+        auto lock = edges_lock_.read();
+        for (EdgeId e : by_time_.ids()) fn(log_.edge(e));
+    }
+
+    // Like forEachEdge, but only visits edges with from <= timestamp <= to. The
+    // window is located by binary search on the time index, so cost tracks the
+    // number of matches rather than the size of the timeline.
+    template <typename Fn>
+    void forEachEdgeInRange(long long from, long long to, Fn&& fn) const {
+        auto lock = edges_lock_.read();
+        auto [b, e] = by_time_.range(from, to);
+        for (size_t i = b; i < e; ++i) fn(log_.edge(by_time_.id(i)));
+    }
+
+    // Visits up to `limit` edges in chronological order starting at `from` and
+    // returns where the next page begins (end set once the timeline is exhausted).
+    // The lock is held for one page only, so ingest can proceed between pages.
+    template <typename Fn>
+    TimelineCursor forEachEdgeFrom(const TimelineCursor& from, size_t limit, Fn&& fn) const {
+        auto lock = edges_lock_.read();
+        size_t i = by_time_.seek(from), n = by_time_.size();
+        for (size_t stop = (limit < n - i) ? i + limit : n; i < stop; ++i) fn(log_.edge(by_time_.id(i)));
+        if (i == n) return { LLONG_MIN, 0, true };
+        return { by_time_.time(i), by_time_.id(i), false };
+    }
+
+    // Number of live edges with from <= timestamp <= to.
+    size_t edgeCountInRange(long long from, long long to) const {
+        auto lock = edges_lock_.read();
+        auto [b, e] = by_time_.range(from, to);
+        return e - b;
+    }
+
+    // --- Helper query methods used by CommandHandler / Investigation ---
+    // Return a vector of neighbors (unique node IDs) for a given node, ascending.
+    std::vector<uint64_t> getNeighbors(uint64_t id) const {
+        auto lock = edges_lock_.read();
+        auto n = neighborsOf(id);
+        return { n.begin(), n.end() };
+    }
+
+    // Return every edge touching `id`, oldest first.
+    std::vector<Edge> getIncidentEdges(uint64_t id) const {
+        auto lock = edges_lock_.read();
+        std::vector<Edge> out;
+        auto it = incidence_.find(id);
+        if (it == incidence_.end()) return out;
+        out.reserve(it->second.size());
+        for (EdgeId e : it->second) out.push_back(log_.edge(e));
+        return out;
+    }
+
+    // Return common neighbors (intersection) of a and b, ascending. Both
+    // neighbor lists are read under one lock, so they describe the same graph.
+    std::vector<uint64_t> getCommonNeighbors(uint64_t a, uint64_t b) const {
+        auto lock = edges_lock_.read();
+        return commonNeighbors(a, b);
+    }
+
+    // |N(a) ∩ N(b)| and |N(a) ∪ N(b)|, counted under one lock without copying either list.
+    std::pair<size_t, size_t> getNeighborOverlap(uint64_t a, uint64_t b) const {
+        auto lock = edges_lock_.read();
+        auto na = neighborsOf(a), nb = neighborsOf(b);
+        size_t shared = SortedIntersect::count(na, nb);
+        return { shared, na.size() + nb.size() - shared };
+    }
+
+    // Calls fn(w, degree, timesWithA, timesWithB) for every common neighbor w of a
+    // and b, ascending; contact times are oldest first. The intersection, degrees
+    // and pair histories all come from one read lock, so fn sees a single version
+    // of the graph. fn must not call back into edge queries or mutate the store.
+    template <typename Fn>
+    void forEachCommonNeighbor(uint64_t a, uint64_t b, Fn&& fn) const {
+        auto lock = edges_lock_.read();
+        for (uint64_t w : commonNeighbors(a, b)) {
+            auto inc = incidence_.find(w);
+            uint32_t degree = (inc == incidence_.end()) ? 0 : static_cast<uint32_t>(inc->second.size());
+            fn(w, degree, pairTimes(a, w), pairTimes(b, w));
+        }
+    }
+
+    // Return all timestamps where there exists an edge between u and v (either direction).
+    // Served from the pair index: one hash lookup, already in chronological order.
+    std::vector<long long> getAllTimestamps(uint64_t u, uint64_t v) const {
+        auto lock = edges_lock_.read();
+        return pairTimes(u, v);
+    }
+
+    // Number of live interactions between u and v.
+    size_t getPairCount(uint64_t u, uint64_t v) const {
+        auto lock = edges_lock_.read();
+        auto it = pairs_.find(pairKey(u, v));
+        return (it == pairs_.end()) ? 0 : it->second.size();
+    }
+
+    // Incrementally maintained degree counters for one node.
+    DegreeIndex::Counts getDegreeCounts(uint64_t id) const {
+        auto lock = edges_lock_.read();
+        return degrees_.counts(id);
+    }
+
+    // Up to k (node, count) pairs with the highest degree under `m`; no graph scan.
+    std::vector<std::pair<uint64_t, uint32_t>> topByDegree(DegreeIndex::Metric m, size_t k) const {
+        auto lock = edges_lock_.read();
+        return degrees_.top(m, k);
+    }
+
+    // Length of the trailing window used by DegreeIndex::Metric::Windowed.
+    void setDegreeWindow(long long seconds) {
+        auto lock = edges_lock_.write();
+        degrees_.setWindow(seconds, by_time_.ids());
     }
 
     // Return degree (number of connections across timeline) for a node.
-    int getDegree(uint64_t id) {
-        std::lock_guard<std::mutex> lock(edges_mutex_);
-        int deg = 0;
-        for (auto const& [t, list] : timeline_)
-            for (auto const& e : list)
-                if (e->source() == id || e->target() == id) ++deg;
-        return deg;
+    int getDegree(uint64_t id) const {
+        auto lock = edges_lock_.read();
+        auto it = incidence_.find(id);
+        return (it == incidence_.end()) ? 0 : static_cast<int>(it->second.size());
     }
 
 private:
+    using PairKey = std::pair<uint64_t, uint64_t>;
+    struct PairHash {
+        size_t operator()(const PairKey& p) const {
+            return std::hash<uint64_t>()(p.first * 0x9E3779B97F4A7C15ULL ^ p.second);
+        }
+    };
+    // Endpoints in canonical order: edges are undirected for pair bookkeeping.
+    static PairKey pairKey(uint64_t a, uint64_t b) { return (a < b) ? PairKey{ a, b } : PairKey{ b, a }; }
+
+    static std::unique_ptr<Node> makeNode(uint64_t id, const std::string& label,
+                                          std::span<const std::string> images, size_t i) {
+        auto n = std::make_unique<Node>(id, label);
+        if (i < images.size() && !images[i].empty()) n->setImage(images[i]);
+        return n;
+    }
+
+    static bool hasImages(std::span<const std::string> images) {
+        return std::any_of(images.begin(), images.end(), [](const std::string& s) { return !s.empty(); });
+    }
+
+    // Unique neighbors of id, ascending. Caller holds edges_lock_.
+    std::span<const uint64_t> neighborsOf(uint64_t id) const {
+        auto it = neighbors_.find(id);
+        if (it == neighbors_.end()) return {};
+        return it->second;
+    }
+
+    // Sorted-list intersection, galloping when one side is a hub. Caller holds edges_lock_.
+    std::vector<uint64_t> commonNeighbors(uint64_t a, uint64_t b) const {
+        auto na = neighborsOf(a), nb = neighborsOf(b);
+        std::vector<uint64_t> out(std::min(na.size(), nb.size()));
+        out.resize(SortedIntersect::run<true>(na, nb, out.data()));
+        return out;
+    }
+
+    // Records that a and b just gained their first edge.
+    void linkNeighbors(uint64_t a, uint64_t b) {
+        insertSorted(neighbors_[a], b);
+        if (b != a) insertSorted(neighbors_[b], a);
+    }
+
+    static void insertSorted(std::vector<uint64_t>& list, uint64_t id) {
+        if (list.empty() || list.back() < id) list.push_back(id);
+        else list.insert(std::lower_bound(list.begin(), list.end(), id), id);
+    }
+
+    // Records that id and other just lost their last edge, on other's side.
+    void unlinkNeighbor(uint64_t other, uint64_t id) {
+        auto it = neighbors_.find(other);
+        if (it == neighbors_.end()) return;
+        auto& list = it->second;
+        auto pos = std::lower_bound(list.begin(), list.end(), id);
+        if (pos != list.end() && *pos == id) list.erase(pos);
+        if (list.empty()) neighbors_.erase(it);
+    }
+
+    // Timestamps of the edges between u and v, oldest first. Caller holds edges_lock_.
+    std::vector<long long> pairTimes(uint64_t u, uint64_t v) const {
+        std::vector<long long> ts;
+        auto it = pairs_.find(pairKey(u, v));
+        if (it == pairs_.end()) return ts;
+        ts.reserve(it->second.size());
+        for (EdgeId e : it->second) ts.push_back(log_.timestamp(e));
+        return ts;
+    }
+
+    uint64_t otherEnd(EdgeId e, uint64_t id) const {
+        uint64_t s = log_.source(e);
+        return (s == id) ? log_.target(e) : s;
+    }
+
+    // Inserts e into a time-ordered ID list. Live ingest is mostly in order, so this
+    // is a push_back in the common case; equal timestamps keep insertion order.
+    void insertByTime(std::vector<EdgeId>& list, EdgeId e) {
+        long long ts = log_.timestamp(e);
+        if (list.empty() || log_.timestamp(list.back()) <= ts) {
+            list.push_back(e);
+            return;
+        }
+        auto pos = std::upper_bound(list.begin(), list.end(), ts,
+            [this](long long t, EdgeId x) { return t < log_.timestamp(x); });
+        list.insert(pos, e);
+    }
+
+    void indexTime(EdgeId e) { by_time_.insert(e, log_.timestamp(e)); }
+    void indexEdge(uint64_t id, EdgeId e) { insertByTime(incidence_[id], e); }
+
+    void unindexEdge(uint64_t id, EdgeId e) {
+        auto it = incidence_.find(id);
+        if (it == incidence_.end()) return;
+        auto& list = it->second;
+        list.erase(std::remove(list.begin(), list.end(), e), list.end());
+        if (list.empty()) incidence_.erase(it);
+    }
+
     uint64_t next_node_id_ = 0;
     std::unordered_map<uint64_t, std::unique_ptr<Node>> nodes_;
-    std::map<long long, std::vector<std::shared_ptr<Edge>>> timeline_;
-    std::mutex nodes_mutex_;
-    std::mutex edges_mutex_;
+    EdgeLog log_;
+    // live edge IDs in chronological order, with a sorted timestamp column
+    TimeIndex by_time_;
+    // node id -> edges touching it, oldest first
+    std::unordered_map<uint64_t, std::vector<EdgeId>> incidence_;
+    // unordered pair -> its live edges, oldest first
+    std::unordered_map<PairKey, std::vector<EdgeId>, PairHash> pairs_;
+    // node id -> distinct counterparts (itself, for a self-loop), ascending;
+    // changes only when a pair gains its first or loses its last edge
+    std::unordered_map<uint64_t, std::vector<uint64_t>> neighbors_;
+    DegreeIndex degrees_{ log_ };
+    std::atomic<uint64_t> version_{0};
+    MutationListener* listener_ = nullptr;
+    std::shared_ptr<const CsrSnapshot> frozen_;
+    std::mutex frozen_mutex_;
+    RWLock edges_lock_;
+    RWLock nodes_lock_;
 };
 
 }
@@ -0,0 +1,102 @@
+#ifndef GRAPH_VIEW_H
+#define GRAPH_VIEW_H
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "core/EdgeLog.h"
+
+namespace graph {
+
+// The graph as of one store version, pinned by GraphStore::pin(). It holds the
+// node IDs and a View of the edge log, so reading it takes no lock at all: the
+// store keeps appending and removing edges behind it, and the segments it pins
+// stay alive until the last GraphView referencing them is gone.
+class GraphView {
+public:
+    GraphView(uint64_t version, std::vector<uint64_t> nodeIds, EdgeLog::View edges, size_t edgeCount,
+              std::vector<std::string> labels = {}, std::vector<std::string> images = {})
+        : version_(version), node_ids_(std::move(nodeIds)), labels_(std::move(labels)),
+          images_(std::move(images)), edges_(std::move(edges)), edge_count_(edgeCount) {}
+
+    uint64_t version() const { return version_; }
+    const std::vector<uint64_t>& nodeIds() const { return node_ids_; }
+    // Parallel to nodeIds(); only filled in by pin(true).
+    bool hasNodeData() const { return labels_.size() == node_ids_.size(); }
+    const std::string& label(size_t i) const { return labels_[i]; }
+    const std::string& image(size_t i) const { return images_[i]; }
+    size_t edgeCount() const { return edge_count_; }
+
+    // Calls fn(source, target, timestamp) for every edge visible at this version,
+    // oldest first with ties in insertion order, the same order as the store's
+    // timeline. In-order ingest needs no sort; otherwise the order is worked out
+    // once, on the first call, and reused.
+    template <typename Fn>
+    void forEachEdge(Fn&& fn) {
+        if (!ordered_) order();
+        if (chronological_) {
+            for (EdgeId e = 0; e < edges_.size(); ++e)
+                if (edges_.visible(e)) fn(edges_.source(e), edges_.target(e), edges_.timestamp(e));
+        } else {
+            for (EdgeId e : by_time_) fn(edges_.source(e), edges_.target(e), edges_.timestamp(e));
+        }
+    }
+
+    // The same walk restricted to from <= timestamp <= to; it stops at the
+    // first edge past `to`.
+    template <typename Fn>
+    void forEachEdgeInRange(long long from, long long to, Fn&& fn) {
+        if (!ordered_) order();
+        if (chronological_) {
+            for (EdgeId e = 0; e < edges_.size(); ++e) {
+                if (!edges_.visible(e)) continue;
+                long long ts = edges_.timestamp(e);
+                if (ts > to) break;
+                if (ts >= from) fn(edges_.source(e), edges_.target(e), ts);
+            }
+        } else {
+            auto it = std::lower_bound(by_time_.begin(), by_time_.end(), from,
+                [this](EdgeId e, long long t) { return edges_.timestamp(e) < t; });
+            for (; it != by_time_.end() && edges_.timestamp(*it) <= to; ++it)
+                fn(edges_.source(*it), edges_.target(*it), edges_.timestamp(*it));
+        }
+    }
+
+private:
+    // EdgeIds grow with insertion, so the log is already chronological unless a
+    // timestamp ever went backwards.
+    void order() {
+        ordered_ = true;
+        long long prev = 0;
+        bool first = true;
+        for (EdgeId e = 0; e < edges_.size() && chronological_; ++e) {
+            if (!edges_.visible(e)) continue;
+            long long ts = edges_.timestamp(e);
+            if (!first && ts < prev) chronological_ = false;
+            prev = ts;
+            first = false;
+        }
+        if (chronological_) return;
+
+        by_time_.reserve(edge_count_);
+        for (EdgeId e = 0; e < edges_.size(); ++e)
+            if (edges_.visible(e)) by_time_.push_back(e);
+        std::stable_sort(by_time_.begin(), by_time_.end(), [this](EdgeId a, EdgeId b) {
+            return edges_.timestamp(a) < edges_.timestamp(b);
+        });
+    }
+
+    uint64_t version_;
+    std::vector<uint64_t> node_ids_;
+    std::vector<std::string> labels_;
+    std::vector<std::string> images_;
+    EdgeLog::View edges_;
+    size_t edge_count_;
+    bool ordered_ = false;
+    bool chronological_ = true;
+    std::vector<EdgeId> by_time_;
+};
+
+}
+#endif
@@ -0,0 +1,31 @@
+#ifndef MUTATION_LISTENER_H
+#define MUTATION_LISTENER_H
+#include <string>
+#include <span>
+#include <cstdint>
+#include "core/EdgeLog.h"
+
+namespace graph {
+
+// Observer for every change made to a GraphStore, installed with setListener.
+// Calls arrive while the store still holds the write lock for the change, so
+// they must be quick and must not call back into the store. `version` is the
+// store version the change produced; changes under different locks (a rename
+// and an edge insert, say) may be reported out of version order, but such
+// changes never touch the same state.
+class MutationListener {
+public:
+    virtual ~MutationListener() = default;
+    // `images` is empty when every node keeps the default image; otherwise it
+    // runs parallel to `labels`, with "" meaning the default.
+    virtual void nodesAdded(uint64_t firstId, std::span<const std::string> labels,
+                            std::span<const std::string> images, uint64_t version) = 0;
+    virtual void edgesAdded(std::span<const EdgeRecord> edges, uint64_t version) = 0;
+    virtual void nodeRenamed(uint64_t id, const std::string& label, uint64_t version) = 0;
+    virtual void nodeImageSet(uint64_t id, const std::string& path, uint64_t version) = 0;
+    virtual void nodeIsolated(uint64_t id, uint64_t version) = 0;
+    virtual void cleared(uint64_t version) = 0;
+};
+
+}
+#endif
@@ -10,6 +10,7 @@ public:
     Node(uint64_t id, std::string label) : id_(id), label_(label), image_path_("default.png") {}
     uint64_t id() const { return id_; }
     std::string label() const { return label_; }
+    void setLabel(std::string label) { label_ = label; }
     void setImage(std::string path) { image_path_ = path; }
     std::string image() const { return image_path_; }
     std::map<std::string, std::string> properties;
@@ -0,0 +1,131 @@
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <string>
+#include <optional>
+#include <climits>
+#include <charconv>
+#include "core/EdgeLog.h"
+
+namespace graph {
+
+// Position in the timeline for paged reads: the first edge at or after
+// (timestamp, edge) in chronological order. Because ties are kept in insertion
+// order and EdgeIds only grow, the timeline is sorted by that pair, so a cursor
+// stays valid across concurrent inserts and removals between pages.
+struct TimelineCursor {
+    long long timestamp = LLONG_MIN;
+    EdgeId edge = 0;
+    bool end = false;
+
+    static TimelineCursor at(long long ts) { return { ts, 0, false }; }
+
+    // Opaque continuation token, "<timestamp>:<edge>", for handing to clients.
+    std::string token() const { return std::to_string(timestamp) + ":" + std::to_string(edge); }
+
+    static std::optional<TimelineCursor> parse(const std::string& tok) {
+        TimelineCursor c;
+        const char* p = tok.data();
+        const char* last = p + tok.size();
+        auto r = std::from_chars(p, last, c.timestamp);
+        if (r.ec != std::errc() || r.ptr == last || *r.ptr != ':') return std::nullopt;
+        r = std::from_chars(r.ptr + 1, last, c.edge);
+        if (r.ec != std::errc() || r.ptr != last) return std::nullopt;
+        return c;
+    }
+};
+
+// Edge IDs in chronological order, with their timestamps kept in a parallel
+// sorted column. Range lookups binary-search the contiguous timestamp column
+// instead of chasing each ID back into the EdgeLog, so a one-hour window over
+// years of events costs O(log E) plus the size of the window.
+class TimeIndex {
+public:
+    // Inserts after any existing entries with the same timestamp, so ties keep
+    // insertion order. In-order ingest is an append.
+    void insert(EdgeId e, long long ts) {
+        if (times_.empty() || times_.back() <= ts) {
+            ids_.push_back(e);
+            times_.push_back(ts);
+            return;
+        }
+        size_t pos = std::upper_bound(times_.begin(), times_.end(), ts) - times_.begin();
+        ids_.insert(ids_.begin() + pos, e);
+        times_.insert(times_.begin() + pos, ts);
+    }
+
+    // Merges a batch that is already in timeline order and whose IDs are all newer
+    // than any in the index. One backwards pass; an append if the batch starts at
+    // or after the current end.
+    template <typename TimeOf>
+    void merge(const std::vector<EdgeId>& batch, TimeOf&& timeOf) {
+        size_t n = ids_.size(), m = batch.size();
+        ids_.resize(n + m);
+        times_.resize(n + m);
+        size_t i = n, k = n + m;
+        for (size_t j = m; j-- > 0;) {
+            long long t = timeOf(batch[j]);
+            // Equal timestamps: the newer ID goes last.
+            while (i > 0 && times_[i - 1] > t) {
+                --i; --k;
+                ids_[k] = ids_[i];
+                times_[k] = times_[i];
+            }
+            --k;
+            ids_[k] = batch[j];
+            times_[k] = t;
+        }
+    }
+
+    // Drops every entry whose ID matches `dead`, keeping both columns aligned.
+    template <typename Pred>
+    void eraseIf(Pred&& dead) {
+        size_t out = 0;
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            if (dead(ids_[i])) continue;
+            ids_[out] = ids_[i];
+            times_[out] = times_[i];
+            ++out;
+        }
+        ids_.resize(out);
+        times_.resize(out);
+    }
+
+    void clear() {
+        ids_.clear();
+        times_.clear();
+    }
+
+    // Positions [first, last) of the entries with lo <= timestamp <= hi.
+    std::pair<size_t, size_t> range(long long lo, long long hi) const {
+        if (lo > hi) return { 0, 0 };
+        auto b = std::lower_bound(times_.begin(), times_.end(), lo);
+        auto e = std::upper_bound(b, times_.end(), hi);
+        return { size_t(b - times_.begin()), size_t(e - times_.begin()) };
+    }
+
+    // Position of the first entry at or after the cursor.
+    size_t seek(const TimelineCursor& c) const {
+        auto b = std::lower_bound(times_.begin(), times_.end(), c.timestamp);
+        auto e = std::upper_bound(b, times_.end(), c.timestamp);
+        size_t lo = b - times_.begin(), hi = e - times_.begin();
+        return std::lower_bound(ids_.begin() + lo, ids_.begin() + hi, c.edge) - ids_.begin();
+    }
+
+    size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+    EdgeId id(size_t pos) const { return ids_[pos]; }
+    long long time(size_t pos) const { return times_[pos]; }
+    const std::vector<EdgeId>& ids() const { return ids_; }
+
+private:
+    std::vector<EdgeId> ids_;
+    std::vector<long long> times_;
+};
+
+}
+#endif
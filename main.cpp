@@ -1,24 +1,45 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <optional>
+#include <charconv>
 #include "core/GraphStore.h"
 #include "CommandHandler.h" // Include the new brain
 //#include "CommandHandler1.h"
 using namespace std;
 using namespace graph;
-int main() {
+
+// Numeric CLI argument: the whole token must parse and fit in T, so junk and
+// overflow are reported instead of throwing out of the command loop.
+template <typename T>
+static optional<T> parseNumber(const string& s) {
+    T v{};
+    auto r = from_chars(s.data(), s.data() + s.size(), v);
+    if (r.ec != errc() || r.ptr != s.data() + s.size()) return nullopt;
+    return v;
+}
+
+int main(int argc, char* argv[]) {
     auto store = make_unique<GraphStore>();
+    unique_ptr<Journal> journal;
+    unique_ptr<IngestQueue> ingest;             // shared by every feed
+    vector<unique_ptr<IngestFeed>> feeds;       // declared last: stopped first on exit
     string line, cmd;
 
     cout << "\n--- ��️    GRAPH ENGINE MASTER CLI v3.8 [COMPLETE] ---" << endl;
     cout << "  [BUILD]    add <n> | connect <u,v> | rename <id,n> | set-img <id,p>" << endl;
-    cout << "  [ANALYZE]  rank    | stats         | redflag       | bottleneck" << endl;
-    cout << "  [NAVIGATE] path    | analyze       | neighbors     | find <txt>    | witness <u,v> | possibility <u,v>" << endl;
+    cout << "  [ANALYZE]  rank [k] [pagerank|ppr <id>|eigen|degree|distinct|window] | stats         | redflag [k] [count] [parallel [n]] | bottleneck [k] [exact|approx [eps]]" << endl;
+    cout << "  [NAVIGATE] path <u,v> [hops|earliest|latest|fastest] | analyze       | neighbors     | find <txt>    | witness <u,v> | possibility <u,v> | reach <src,ts,[ids]> | similar [k] [jaccard|adamic|ra]" << endl;
     cout << "  [SECURITY] isolate | purge         | dossier <id>" << endl;
-    cout << "  [HISTORY]  save    | load          | timeline      | forensics <s,e>" << endl;
-    cout << "  [SYSTEM]   list    | export        | clear         | exit" << endl;
+    cout << "  [HISTORY]  save [bin] | load [bin] | timeline [s,e|page] | forensics <s,e> | journal [dir|off] | checkpoint | recover <dir>" << endl;
+    cout << "  [INGEST]   ingest <file|fifo> (lines: src dst [ts]) | ingest | ingest stop" << endl;
+    cout << "  [SYSTEM]   list    | export [s,e] [file|-] | csv export|import <edges> [nodes] [s,e] | clear | exit" << endl;
     cout << "--------------------------------------------------------" << endl;
 
+    // graph_engine --recover <dir> [always|interval|never]: rebuild from a journal before taking commands.
+    if (argc >= 3 && string(argv[1]) == "--recover")
+        journal = CommandHandler::recoverJournal(store.get(), argv[2], argc >= 4 ? argv[3] : "always");
+
     while (true) {
         cout << "graph-engine> ";
         if (!getline(cin, line)) break;
@@ -74,16 +95,94 @@ int main() {
         }
         else if (cmd == "set-img") {
             uint64_t id; string p;
-            if(ss >> id >> p && store->getNodes().count(id)) {
-                store->getNodes()[id]->setImage(p); cout << "��️ Image set." << endl;
-            }
+            if(ss >> id >> p && store->setNodeImage(id, p)) cout << "��️ Image set." << endl;
         }
 
         // --- [ANALYZE] ---
-        else if (cmd == "rank") CommandHandler::showRank(store.get());
+        else if (cmd == "rank") {
+            // rank [k] [pagerank|ppr <seed>|eigen|degree|distinct|window [s]] [decay <half-life s>]
+            size_t k = SIZE_MAX; string arg, mode = "pagerank";
+            uint64_t seed = 0; long long halfLife = 0, window = 0; string bad;
+            while (ss >> arg) {
+                if (arg == "ppr" || arg == "decay") {
+                    string v;
+                    if (!(ss >> v)) { cout << "❌ Usage: rank ... " << arg << (arg == "ppr" ? " <id>" : " <half-life s>") << endl; mode.clear(); break; }
+                    if (arg == "ppr") {
+                        auto n = parseNumber<uint64_t>(v);
+                        if (!n) { bad = v; break; }
+                        mode = arg; seed = *n;
+                    } else {
+                        auto n = parseNumber<long long>(v);
+                        if (!n || *n < 0) { bad = v; break; }
+                        halfLife = *n;
+                    }
+                }
+                else if (arg == "window") {
+                    // optional new window length; applied only once the whole command parses
+                    mode = arg;
+                    string secs;
+                    if (ss >> secs) {
+                        auto n = parseNumber<long long>(secs);
+                        if (!n || *n <= 0) { bad = secs; break; }
+                        window = *n;
+                    }
+                }
+                else if (isdigit((unsigned char)arg[0])) {
+                    auto n = parseNumber<size_t>(arg);
+                    if (!n) { bad = arg; break; }
+                    k = *n;
+                }
+                else if (arg == "pagerank" || arg == "eigen" || arg == "degree" || arg == "distinct") mode = arg;
+                else { cout << "❌ Unknown rank mode: " << arg << endl; mode.clear(); break; }
+            }
+            if (mode.empty()) continue;
+            if (!bad.empty()) { cout << "❌ Bad number: " << bad << endl; continue; }
+            if (window > 0) store->setDegreeWindow(window);
+            if (mode == "degree") CommandHandler::showRank(store.get(), k, DegreeIndex::Metric::Total);
+            else if (mode == "distinct") CommandHandler::showRank(store.get(), k, DegreeIndex::Metric::Distinct);
+            else if (mode == "window") CommandHandler::showRank(store.get(), k, DegreeIndex::Metric::Windowed);
+            else if (mode == "ppr") CommandHandler::showCentrality(store.get(), k, CommandHandler::CentralityKind::Personalized, seed, halfLife);
+            else if (mode == "eigen") CommandHandler::showCentrality(store.get(), k, CommandHandler::CentralityKind::Eigenvector, 0, halfLife);
+            else CommandHandler::showCentrality(store.get(), k, CommandHandler::CentralityKind::PageRank, 0, halfLife);
+        }
         else if (cmd == "stats") CommandHandler::showStats(store.get());
-        else if (cmd == "redflag") CommandHandler::runRedFlag(store.get());
-        else if (cmd == "bottleneck") CommandHandler::showBottlenecks(store.get());
+        else if (cmd == "redflag") {
+            // redflag [k] [count] [parallel [threads]]
+            unsigned k = 3, threads = 1; bool countOnly = false, parallel = false; string arg, bad;
+            while (ss >> arg) {
+                if (arg == "count") countOnly = true;
+                else if (arg == "parallel") { parallel = true; threads = 0; }
+                else if (isdigit((unsigned char)arg[0])) {
+                    auto n = parseNumber<unsigned>(arg);
+                    if (!n) { bad = arg; break; }
+                    if (parallel) threads = min(*n, WorkStealing::defaultThreads());
+                    else k = *n;
+                }
+            }
+            if (!bad.empty()) cout << "❌ Bad number: " << bad << endl;
+            else CommandHandler::runRedFlag(store.get(), k, countOnly, threads);
+        }
+        else if (cmd == "bottleneck") {
+            // bottleneck [k] [exact|approx [epsilon]]
+            size_t k = 10; double eps = 0.01; string arg, bad;
+            while (ss >> arg) {
+                if (arg == "exact") eps = 0;
+                else if (arg == "approx") {
+                    string e;
+                    if (!(ss >> e)) continue;
+                    auto n = parseNumber<double>(e);
+                    if (!n || !(*n > 0 && *n < 1)) { bad = e + " (approx epsilon must lie in (0, 1))"; break; }
+                    eps = *n;
+                }
+                else if (isdigit((unsigned char)arg[0])) {
+                    auto n = parseNumber<size_t>(arg);
+                    if (!n) { bad = arg; break; }
+                    k = *n;
+                }
+            }
+            if (!bad.empty()) cout << "❌ Bad number: " << bad << endl;
+            else CommandHandler::showBottlenecks(store.get(), k, eps);
+        }
         else if (cmd == "possibility") {
             uint64_t u, v;
             if (ss >> u >> v) CommandHandler::calculatePossibility(store.get(), u, v);
@@ -91,7 +190,43 @@ int main() {
         }
 
         // --- [NAVIGATE] ---
-        else if (cmd == "path") { uint64_t u, v; if(ss >> u >> v) CommandHandler::findPath(store.get(), u, v); }
+        else if (cmd == "path") {
+            // path <u> <v> [hops|earliest|latest|fastest]
+            uint64_t u, v; string m;
+            if (ss >> u >> v) {
+                ss >> m;
+                auto mode = TemporalPaths::Mode::FewestHops;
+                if (m == "earliest") mode = TemporalPaths::Mode::EarliestArrival;
+                else if (m == "latest") mode = TemporalPaths::Mode::LatestDeparture;
+                else if (m == "fastest") mode = TemporalPaths::Mode::Fastest;
+                CommandHandler::findPath(store.get(), u, v, mode);
+            }
+        }
+        else if (cmd == "reach") {
+            // reach <src> <from_ts> [target ...]
+            uint64_t src; long long from;
+            if (ss >> src >> from) {
+                vector<uint64_t> targets; uint64_t t;
+                while (ss >> t) targets.push_back(t);
+                CommandHandler::showReachability(store.get(), src, from, targets);
+            } else cout << "❌ Usage: reach <src> <from_ts> [target ...]" << endl;
+        }
+        else if (cmd == "similar") {
+            // similar [k] [jaccard|adamic|ra]
+            size_t k = 10; auto metric = LinkPredictionOptions::Metric::AdamicAdar; string arg, bad;
+            while (ss >> arg) {
+                if (arg == "jaccard") metric = LinkPredictionOptions::Metric::Jaccard;
+                else if (arg == "ra") metric = LinkPredictionOptions::Metric::ResourceAllocation;
+                else if (arg == "adamic") metric = LinkPredictionOptions::Metric::AdamicAdar;
+                else if (isdigit((unsigned char)arg[0])) {
+                    auto n = parseNumber<size_t>(arg);
+                    if (!n) { bad = arg; break; }
+                    k = *n;
+                }
+            }
+            if (!bad.empty()) cout << "❌ Bad number: " << bad << endl;
+            else CommandHandler::showSimilarPairs(store.get(), k, metric);
+        }
         else if (cmd == "neighbors") { uint64_t id; if(ss >> id) CommandHandler::showNeighbors(store.get(), id); }
         else if (cmd == "find") { string q; ss >> q; CommandHandler::findNode(store.get(), q); }
         else if (cmd == "witness") { uint64_t u, v; if(ss >> u >> v) CommandHandler::findWitness(store.get(), u, v); }
@@ -99,20 +234,113 @@ int main() {
         // --- [SECURITY] ---
         else if (cmd == "isolate") { uint64_t id; if(ss >> id) CommandHandler::isolateNode(store.get(), id); }
         else if (cmd == "dossier") { uint64_t id; if(ss >> id) CommandHandler::runDossier(store.get(), id); }
-        else if (cmd == "purge" || cmd == "clear") { store = make_unique<GraphStore>(); cout << "♻️ Memory Purged." << endl; }
+        else if (cmd == "purge" || cmd == "clear") CommandHandler::purgeGraph(store.get());
 
         // --- [HISTORY & SYSTEM] ---
-        else if (cmd == "save") CommandHandler::saveSnapshot(store.get());
-        else if (cmd == "load") CommandHandler::loadSnapshot(store.get());
+        else if (cmd == "save" || cmd == "load") {
+            // save|load [bin [file]]
+            string fmt, file = "graph_snapshot.bin";
+            if (ss >> fmt && fmt == "bin") {
+                ss >> file;
+                if (cmd == "save") CommandHandler::saveBinarySnapshot(store.get(), file);
+                else CommandHandler::loadBinarySnapshot(store.get(), file);
+            }
+            else if (cmd == "save") CommandHandler::saveSnapshot(store.get());
+            else CommandHandler::loadSnapshot(store.get());
+        }
+        else if (cmd == "journal") {
+            // journal [<dir> [always|interval|never] | off]
+            string dir, policy = "always";
+            if (!(ss >> dir)) CommandHandler::showJournal(journal.get());
+            else if (dir == "off") { journal.reset(); cout << "�� Journal closed." << endl; }
+            else {
+                ss >> policy;
+                journal.reset();
+                journal = CommandHandler::startJournal(store.get(), dir, policy);
+            }
+        }
+        else if (cmd == "recover") {
+            // recover <dir> [always|interval|never]
+            string dir, policy = "always";
+            if (ss >> dir) {
+                ss >> policy;
+                journal.reset();
+                journal = CommandHandler::recoverJournal(store.get(), dir, policy);
+            } else cout << "❌ Usage: recover <dir> [always|interval|never]" << endl;
+        }
+        else if (cmd == "checkpoint") CommandHandler::runCheckpoint(journal.get());
+        else if (cmd == "csv") {
+            // csv export|import <edges.csv|.tsv> [nodes.csv] [from_ts to_ts]
+            string op, edges, nodes, arg; long long s = LLONG_MIN, e = LLONG_MAX;
+            ss >> op >> edges;
+            if (ss >> arg) {
+                stringstream as(arg);
+                if (!(as >> s) || !as.eof()) { s = LLONG_MIN; nodes = arg; ss >> s; }
+                if (!(ss >> e)) e = LLONG_MAX;
+            }
+            if (edges.empty() || (op != "export" && op != "import"))
+                cout << "❌ Usage: csv export|import <edges.csv> [nodes.csv] [from_ts to_ts]\n"
+                        "   import adds new nodes and edges to the current graph (clear first to replace it)" << endl;
+            else if (op == "export") CommandHandler::exportCSV(store.get(), edges, nodes, s, e);
+            else CommandHandler::importCSV(store.get(), edges, nodes, s, e);
+        }
+        else if (cmd == "ingest") {
+            // ingest [<file|fifo> | stop]
+            string arg;
+            if (!(ss >> arg)) CommandHandler::showIngest(ingest.get(), feeds);
+            else if (arg == "stop") CommandHandler::stopIngest(ingest, feeds);
+            else CommandHandler::startFeed(store.get(), ingest, feeds, arg);
+        }
         else if (cmd == "list") CommandHandler::listNodes(store.get());
-        else if (cmd == "timeline") CommandHandler::showTimeline(store.get());
+        else if (cmd == "timeline") {
+            // timeline [from_ts to_ts] | timeline page [start_ts|token] [limit]
+            string arg;
+            if (ss >> arg && arg == "page") {
+                TimelineCursor from; size_t limit = 50; string pos;
+                if (ss >> pos) {
+                    if (auto c = TimelineCursor::parse(pos)) from = *c;
+                    else if (auto ts = parseNumber<long long>(pos)) from = TimelineCursor::at(*ts);
+                    else { cout << "❌ Bad page token: " << pos << endl; continue; }
+                    string lim;
+                    if (ss >> lim) {
+                        auto n = parseNumber<size_t>(lim);
+                        if (!n || *n == 0) { cout << "❌ Bad page size: " << lim << endl; continue; }
+                        limit = *n;
+                    }
+                }
+                CommandHandler::showTimelinePage(store.get(), from, limit);
+            } else {
+                long long s = LLONG_MIN, e = LLONG_MAX;
+                if (!arg.empty()) {
+                    stringstream as(arg);
+                    if (!(as >> s)) { cout << "❌ Usage: timeline [from_ts to_ts] | timeline page [start_ts|token] [limit]" << endl; continue; }
+                    if (!(ss >> e)) e = LLONG_MAX;
+                }
+                CommandHandler::showTimeline(store.get(), s, e);
+            }
+        }
         else if (cmd == "forensics") {
             long long s, e;
             if(ss >> s >> e) CommandHandler::runForensics(store.get(), s, e);
         }
-        else if (cmd == "export" || cmd == "json") CommandHandler::exportJSON(store.get());
+        else if (cmd == "export" || cmd == "json") {
+            // export [from_ts to_ts] [file|-]
+            long long s = LLONG_MIN, e = LLONG_MAX; string arg, file = "graph_data.json";
+            if (ss >> arg) {
+                stringstream as(arg);
+                if (!(as >> s) || !as.eof()) { s = LLONG_MIN; file = arg; }
+                else if (ss >> arg) {
+                    stringstream bs(arg);
+                    if (!(bs >> e) || !bs.eof()) { e = LLONG_MAX; file = arg; }
+                    else ss >> file;
+                }
+            }
+            CommandHandler::exportJSON(store.get(), s, e, file);
+        }
 
         else { cout << "❓ Unknown command: " << cmd << endl; }
+
+        if (journal && !journal->commit()) cout << "⚠️ Journal write failed; changes are no longer being persisted." << endl;
     }
     return 0;
 }
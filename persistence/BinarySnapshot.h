@@ -0,0 +1,266 @@
+#pragma once
+#include "core/GraphStore.h"
+#include "persistence/MappedFile.h"
+#include "persistence/FileSync.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <unistd.h>
+
+namespace graph {
+
+// Versioned binary snapshot, laid out so that a memory-mapped file can be read
+// without parsing. Native byte order (checked on open); every section is 8-byte aligned.
+//
+//   Header
+//   uint64_t nodeIds[nodeCount]
+//   uint64_t stringOffsets[2 * nodeCount + 1]   label i = [2i, 2i+1), image i = [2i+1, 2i+2)
+//   char     strings[stringBytes]
+//   uint64_t sources[edgeCount]                 edge columns, timeline order
+//   uint64_t targets[edgeCount]
+//   int64_t  timestamps[edgeCount]              ascending
+//
+// No index is stored. The store's time, incidence, pair and degree indexes are
+// keyed by its own node and edge IDs, which load() assigns afresh, so the bulk
+// insert rebuilds them all.
+struct BinarySnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t nodeCount;
+    uint64_t edgeCount;
+    uint64_t nodeIdsOffset;
+    uint64_t stringOffsetsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringBytes;
+    uint64_t sourcesOffset;
+    uint64_t targetsOffset;
+    uint64_t timestampsOffset;
+    uint64_t fileSize;
+    uint64_t storeVersion;      // GraphStore::version() when written
+};
+
+// Read-only view of a binary snapshot file. The accessors point straight into
+// the mapping, which lives as long as this object; load() copies from them into
+// the store.
+class MappedSnapshot {
+public:
+    static constexpr char kMagic[8] = { 'G', 'F', 'E', 'S', 'N', 'A', 'P', 0 };
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrder = 0x01020304;
+
+    // Returns nullptr and sets `error` if the file is missing, truncated or not a
+    // snapshot this build understands.
+    static std::unique_ptr<MappedSnapshot> open(const std::string& path, std::string& error) {
+        auto file = MappedFile::open(path, error);
+        if (!file) return nullptr;
+        if (file->size() < sizeof(BinarySnapshotHeader)) { error = "not a snapshot (too small)"; return nullptr; }
+        std::unique_ptr<MappedSnapshot> snap(new MappedSnapshot(std::move(file)));
+        if (!snap->validate(error)) return nullptr;
+        snap->file_->adviseSequential();
+        return snap;
+    }
+
+    size_t nodeCount() const { return header().nodeCount; }
+    uint64_t storeVersion() const { return header().storeVersion; }
+    size_t edgeCount() const { return header().edgeCount; }
+
+    uint64_t nodeId(size_t i) const { return column<uint64_t>(header().nodeIdsOffset)[i]; }
+    std::string_view label(size_t i) const { return string(2 * i); }
+    std::string_view image(size_t i) const { return string(2 * i + 1); }
+
+    const uint64_t* sources() const { return column<uint64_t>(header().sourcesOffset); }
+    const uint64_t* targets() const { return column<uint64_t>(header().targetsOffset); }
+    const int64_t* timestamps() const { return column<int64_t>(header().timestampsOffset); }
+
+private:
+    explicit MappedSnapshot(std::unique_ptr<MappedFile> file)
+        : file_(std::move(file)), base_(file_->data()), size_(file_->size()) {}
+
+    const BinarySnapshotHeader& header() const { return *reinterpret_cast<const BinarySnapshotHeader*>(base_); }
+
+    template <typename T>
+    const T* column(uint64_t offset) const { return reinterpret_cast<const T*>(base_ + offset); }
+
+    std::string_view string(size_t slot) const {
+        const uint64_t* off = column<uint64_t>(header().stringOffsetsOffset);
+        return { base_ + header().stringsOffset + off[slot], size_t(off[slot + 1] - off[slot]) };
+    }
+
+    // Checks that every section lies inside the file, so the accessors never read
+    // past the mapping. The string offsets are walked once; the rest is O(1).
+    bool validate(std::string& error) const {
+        const BinarySnapshotHeader& h = header();
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) { error = "not a snapshot (bad magic)"; return false; }
+        if (h.byteOrder != kByteOrder) { error = "snapshot was written with a different byte order"; return false; }
+        if (h.version != kVersion) { error = "unsupported snapshot version " + std::to_string(h.version); return false; }
+        if (h.fileSize != size_) { error = "snapshot is truncated"; return false; }
+
+        auto fits = [&](uint64_t offset, uint64_t count, uint64_t width) {
+            return offset % 8 == 0 && offset <= size_ && count <= (size_ - offset) / width;
+        };
+        uint64_t n = h.nodeCount, m = h.edgeCount;
+        if (n > size_ / 8 || m > size_ / 8
+            || !fits(h.nodeIdsOffset, n, 8) || !fits(h.stringOffsetsOffset, 2 * n + 1, 8)
+            || h.stringsOffset > size_ || h.stringBytes > size_ - h.stringsOffset
+            || !fits(h.sourcesOffset, m, 8) || !fits(h.targetsOffset, m, 8) || !fits(h.timestampsOffset, m, 8)) {
+            error = "snapshot sections out of bounds";
+            return false;
+        }
+        // load() sends edges with unknown endpoints to the first node; there must be one.
+        if (n == 0 && m > 0) { error = "snapshot has edges but no nodes"; return false; }
+        const uint64_t* off = column<uint64_t>(h.stringOffsetsOffset);
+        if (off[0] != 0) { error = "corrupt string table"; return false; }
+        for (uint64_t i = 1; i <= 2 * n; ++i)
+            if (off[i] < off[i - 1] || off[i] > h.stringBytes) { error = "corrupt string table"; return false; }
+        return true;
+    }
+
+    std::unique_ptr<MappedFile> file_;
+    const char* base_;
+    size_t size_;
+};
+
+class BinarySnapshot {
+public:
+    // Writes the store to `path` via a temporary file, an fsync and a rename, so
+    // a crash mid-save leaves the previous snapshot intact. Returns false on I/O failure.
+    static bool save(const GraphStore& store, const std::string& path) {
+        GraphView view = store.pin(true);
+        return save(view, path);
+    }
+
+    // Same, from a view pinned with node data. Writers are not held up while the
+    // file is written, and the file is exactly the graph at view.version().
+    static bool save(GraphView& view, const std::string& path) {
+        const std::vector<uint64_t>& ids = view.nodeIds();
+        std::vector<uint64_t> stringOffsets{ 0 };
+        std::string strings;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            strings += view.label(i);
+            stringOffsets.push_back(strings.size());
+            strings += view.image(i);
+            stringOffsets.push_back(strings.size());
+        }
+        std::vector<uint64_t> sources, targets;
+        std::vector<int64_t> timestamps;
+        sources.reserve(view.edgeCount());
+        targets.reserve(view.edgeCount());
+        timestamps.reserve(view.edgeCount());
+        view.forEachEdge([&](uint64_t src, uint64_t tgt, long long ts) {
+            sources.push_back(src);
+            targets.push_back(tgt);
+            timestamps.push_back(ts);
+        });
+
+        BinarySnapshotHeader h{};
+        std::memcpy(h.magic, MappedSnapshot::kMagic, sizeof(h.magic));
+        h.version = MappedSnapshot::kVersion;
+        h.byteOrder = MappedSnapshot::kByteOrder;
+        h.storeVersion = view.version();
+        h.nodeCount = ids.size();
+        h.edgeCount = sources.size();
+        uint64_t at = align(sizeof(h));
+        auto place = [&](uint64_t bytes) { uint64_t o = at; at = align(at + bytes); return o; };
+        h.nodeIdsOffset = place(ids.size() * 8);
+        h.stringOffsetsOffset = place(stringOffsets.size() * 8);
+        h.stringBytes = strings.size();
+        h.stringsOffset = place(strings.size());
+        h.sourcesOffset = place(sources.size() * 8);
+        h.targetsOffset = place(targets.size() * 8);
+        h.timestampsOffset = place(timestamps.size() * 8);
+        h.fileSize = at;
+
+        std::string tmp = path + ".tmp";
+        FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+        bool ok = true;
+        auto put = [&](uint64_t offset, const void* data, size_t bytes) {
+            if (!ok || bytes == 0) return;
+            ok = std::fseek(f, (long)offset, SEEK_SET) == 0 && std::fwrite(data, 1, bytes, f) == bytes;
+        };
+        put(0, &h, sizeof(h));
+        put(h.nodeIdsOffset, ids.data(), ids.size() * 8);
+        put(h.stringOffsetsOffset, stringOffsets.data(), stringOffsets.size() * 8);
+        put(h.stringsOffset, strings.data(), strings.size());
+        put(h.sourcesOffset, sources.data(), sources.size() * 8);
+        put(h.targetsOffset, targets.data(), targets.size() * 8);
+        put(h.timestampsOffset, timestamps.data(), timestamps.size() * 8);
+        // Zero-fill any trailing alignment so the file is exactly fileSize bytes.
+        ok = ok && std::fflush(f) == 0 && ftruncate(fileno(f), (off_t)h.fileSize) == 0 && fsync(fileno(f)) == 0;
+        ok = (std::fclose(f) == 0) && ok;
+        if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        FileSync::directoryOf(path);
+        return true;
+    }
+
+    // Replaces the store's contents with the snapshot. File node IDs are remapped
+    // to fresh store IDs, as with the text format; edges to unknown IDs go to the
+    // first loaded node. The edge columns are already in timeline order, so the
+    // bulk insert appends them without sorting.
+    static void load(GraphStore& store, const MappedSnapshot& snap) {
+        store.clear();
+        size_t n = snap.nodeCount(), m = snap.edgeCount();
+        std::vector<std::string> labels, images;
+        nodeStrings(snap, labels, images);
+        uint64_t first = store.addNodes(labels, images);
+
+        std::unordered_map<uint64_t, uint64_t> idMap;
+        idMap.reserve(n);
+        for (size_t i = 0; i < n; ++i) idMap[snap.nodeId(i)] = first + i;
+        auto remap = [&](uint64_t id) {
+            auto it = idMap.find(id);
+            return it == idMap.end() ? first : it->second;
+        };
+        std::vector<EdgeRecord> edges(m);
+        const uint64_t* src = snap.sources();
+        const uint64_t* tgt = snap.targets();
+        const int64_t* ts = snap.timestamps();
+        for (size_t i = 0; i < m; ++i) edges[i] = { remap(src[i]), remap(tgt[i]), ts[i] };
+        store.addEdges(edges);
+    }
+
+    // Like load, but keeps the file's node IDs, for journal checkpoints whose log
+    // records refer to them. Edges are restored exactly as stored.
+    static void restore(GraphStore& store, const MappedSnapshot& snap) {
+        store.clear();
+        size_t n = snap.nodeCount(), m = snap.edgeCount();
+        std::vector<uint64_t> ids(n);
+        for (size_t i = 0; i < n; ++i) ids[i] = snap.nodeId(i);
+        std::vector<std::string> labels, images;
+        nodeStrings(snap, labels, images);
+        store.restoreNodes(ids, labels, images);
+        std::vector<EdgeRecord> edges(m);
+        const uint64_t* src = snap.sources();
+        const uint64_t* tgt = snap.targets();
+        const int64_t* ts = snap.timestamps();
+        for (size_t i = 0; i < m; ++i) edges[i] = { src[i], tgt[i], ts[i] };
+        store.addEdges(edges);
+    }
+
+private:
+    // Labels and images for the bulk node insert; the default image becomes "".
+    static void nodeStrings(const MappedSnapshot& snap, std::vector<std::string>& labels,
+                            std::vector<std::string>& images) {
+        size_t n = snap.nodeCount();
+        labels.reserve(n);
+        images.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            labels.emplace_back(snap.label(i));
+            std::string_view img = snap.image(i);
+            images.emplace_back(img == "default.png" ? std::string_view() : img);
+        }
+    }
+
+    static uint64_t align(uint64_t x) { return (x + 7) & ~uint64_t(7); }
+};
+
+}
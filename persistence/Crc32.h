@@ -0,0 +1,31 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace graph {
+
+// CRC-32C (Castagnoli), table-driven. Used to tell a torn or corrupt log
+// record from a good one.
+class Crc32 {
+    static constexpr std::array<uint32_t, 256> makeTable() {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }
+
+public:
+    static uint32_t compute(const void* data, size_t size, uint32_t crc = 0) {
+        static constexpr std::array<uint32_t, 256> table = makeTable();
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+};
+
+}
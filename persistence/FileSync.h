@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace graph {
+
+// Small POSIX helpers for files that must survive a crash.
+class FileSync {
+public:
+    // Writes all `size` bytes, retrying short writes and EINTR.
+    static bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd, data, size);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += n;
+            size -= size_t(n);
+        }
+        return true;
+    }
+
+    // Makes a create, rename or unlink of `path` durable by syncing its directory.
+    static bool directoryOf(const std::string& path) {
+        size_t slash = path.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+        if (fd < 0) return false;
+        bool ok = fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+    }
+};
+
+}
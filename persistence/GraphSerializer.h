@@ -1,15 +1,400 @@
 #pragma once
 #include "core/GraphStore.h"
-#include <fstream>
+#include "persistence/MappedFile.h"
+#include "concurrency/WorkStealing.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <cctype>
+#include <memory>
+#include <algorithm>
+#include <initializer_list>
 
 namespace graph {
-    class GraphSerializer {
+
+// CSV/TSV interchange with other tools, one table per file:
+//   edges   Source,Target,Timestamp   (the timeline_data.csv shape)
+//   nodes   Id,Label,Image
+// Fields holding the delimiter, a quote or a line break are "quoted", with ""
+// for a quote (RFC 4180), in both dialects. Output is formatted with to_chars
+// into a large buffer; input is memory-mapped, and the edge table is cut into
+// record-aligned chunks (a quoted line break never splits one) that are parsed
+// concurrently with from_chars.
+class GraphSerializer {
+public:
+    struct Options {
+        char delimiter = 0;                 // 0: tab for .tsv/.tab paths, comma otherwise
+        long long from = LLONG_MIN;         // only edges with from <= timestamp <= to
+        long long to = LLONG_MAX;
+        unsigned threads = 0;               // import only; 0 uses every core
+    };
+
+    struct Result {
+        bool ok = false;
+        std::string error;
+        size_t nodes = 0;       // nodes created
+        size_t edges = 0;
+        size_t skipped = 0;     // rows with a missing or malformed field
+        size_t filtered = 0;    // edges outside the time range
+    };
+
+    // Writes the timeline (or the part inside opt's range) in time order. The
+    // store is pinned first, so its locks are not held while the file is written.
+    static bool toCSV(const GraphStore& store, const std::string& path) { return toCSV(store, path, Options{}); }
+    static bool toCSV(const GraphStore& store, const std::string& path, Options opt) {
+        GraphView view = store.pin();
+        return toCSV(view, path, opt);
+    }
+    static bool toCSV(GraphView& view, const std::string& path, Options opt) {
+        char d = delimiterFor(path, opt);
+        Output out(path);
+        if (!out.ok()) return false;
+        out.put("Source").put(d).put("Target").put(d).put("Timestamp").put('\n');
+        view.forEachEdgeInRange(opt.from, opt.to, [&](uint64_t src, uint64_t tgt, long long ts) {
+            out.number(src).put(d).number(tgt).put(d).number(ts).put('\n');
+        });
+        return out.close();
+    }
+
+    static bool nodesToCSV(const GraphStore& store, const std::string& path) { return nodesToCSV(store, path, Options{}); }
+    static bool nodesToCSV(const GraphStore& store, const std::string& path, Options opt) {
+        GraphView view = store.pin(true);
+        return nodesToCSV(view, path, opt);
+    }
+    // `view` must come from pin(true). Writing both tables from the same view
+    // keeps them at one version: every edge's endpoints are in the node table.
+    static bool nodesToCSV(GraphView& view, const std::string& path, Options opt) {
+        char d = delimiterFor(path, opt);
+        Output out(path);
+        if (!out.ok()) return false;
+        out.put("Id").put(d).put("Label").put(d).put("Image").put('\n');
+        const std::vector<uint64_t>& ids = view.nodeIds();
+        for (size_t i = 0; i < ids.size(); ++i)
+            out.number(ids[i]).put(d).field(view.label(i), d).put(d).field(view.image(i), d).put('\n');
+        return out.close();
+    }
+
+    // Adds the edge table at `edgesPath`, plus the node table at `nodesPath` if
+    // given, to the store. Every node row and every endpoint not in the node
+    // table becomes a new node (label = its ID when none is given); IDs are
+    // matched as text within the files, so names work as well as numbers, but
+    // never against nodes already in the store: importing the same tables twice
+    // adds the graph twice. A first row whose timestamp is not a number is a
+    // header, and its column names (Source, Target, Timestamp/Time/Ts; Id,
+    // Label, Image) pick the columns. Nothing is added if a file cannot be read.
+    static Result fromCSV(GraphStore& store, const std::string& edgesPath, const std::string& nodesPath = "") {
+        return fromCSV(store, edgesPath, nodesPath, Options{});
+    }
+    static Result fromCSV(GraphStore& store, const std::string& edgesPath, const std::string& nodesPath, Options opt) {
+        Result res;
+        std::unique_ptr<MappedFile> nodeFile;
+        std::vector<NodeRow> nodeRows;
+        std::deque<std::string> nodeOwned;
+        if (!nodesPath.empty()) {
+            nodeFile = MappedFile::open(nodesPath, res.error);
+            if (!nodeFile) return res;
+            parseNodes(nodeFile->data(), nodeFile->data() + nodeFile->size(), delimiterFor(nodesPath, opt),
+                       nodeRows, nodeOwned, res.skipped);
+        }
+        auto edgeFile = MappedFile::open(edgesPath, res.error);
+        if (!edgeFile) return res;
+        edgeFile->adviseSequential();
+
+        // Header, if any, decides the columns; the chunks start after it.
+        char d = delimiterFor(edgesPath, opt);
+        const char* data = edgeFile->data();
+        const char* end = data + edgeFile->size();
+        Columns cols{ 0, 1, 2 };
+        std::vector<std::string_view> fields;
+        std::deque<std::string> scratch;
+        const char* body = row(data, end, d, fields, scratch);
+        long long ts;
+        if (fields.size() > 2 && !number(fields[2], ts)) cols = edgeColumns(fields);
+        else body = data;
+
+        unsigned threads = opt.threads ? opt.threads : WorkStealing::defaultThreads();
+        size_t skip = body - data;
+        std::vector<size_t> cut = edgeFile->lineChunks(kMinChunk, size_t(threads) * 4);
+        for (auto& c : cut) c = std::max(c, skip);
+        alignToRecords(data, edgeFile->size(), d, cut);
+        size_t chunks = cut.size() - 1;
+        std::vector<EdgeChunk> parsed(chunks);
+        WorkStealing::run(chunks, threads, 1, [&](size_t b, size_t e, unsigned) {
+            for (size_t c = b; c < e; ++c) parseEdges(data + cut[c], data + cut[c + 1], d, cols, opt, parsed[c]);
+        });
+
+        // IDs in file order: node rows first, then endpoints as they appear.
+        std::unordered_map<std::string_view, uint64_t> index;
+        std::vector<std::string> labels;
+        std::vector<std::pair<uint64_t, std::string_view>> images;
+        auto lookup = [&](std::string_view key, std::string_view label) {
+            auto [it, fresh] = index.try_emplace(key, labels.size());
+            if (fresh) labels.emplace_back(label.empty() ? key : label);
+            return it->second;
+        };
+        for (auto const& n : nodeRows) {
+            uint64_t i = lookup(n.key, n.label);
+            if (!n.image.empty() && n.image != "default.png") images.push_back({ i, n.image });
+        }
+        size_t total = 0;
+        for (auto const& c : parsed) {
+            total += c.rows.size();
+            res.skipped += c.skipped;
+            res.filtered += c.filtered;
+        }
+        std::vector<EdgeRecord> edges;
+        edges.reserve(total);
+        for (auto const& c : parsed)
+            for (auto const& r : c.rows) edges.push_back({ lookup(r.source, {}), lookup(r.target, {}), r.timestamp });
+
+        std::vector<std::string> nodeImages;
+        if (!images.empty()) nodeImages.resize(labels.size());
+        for (auto const& [i, img] : images) nodeImages[i] = img;
+        uint64_t first = store.addNodes(labels, nodeImages);
+        for (auto& e : edges) {
+            e.source += first;
+            e.target += first;
+        }
+        store.addEdges(edges);
+        res.nodes = labels.size();
+        res.edges = edges.size();
+        res.ok = true;
+        return res;
+    }
+
+    static char delimiterFor(const std::string& path, const Options& opt) {
+        if (opt.delimiter) return opt.delimiter;
+        auto ends = [&](std::string_view ext) {
+            return path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+        };
+        return ends(".tsv") || ends(".tab") ? '\t' : ',';
+    }
+
+private:
+    static constexpr size_t kMinChunk = size_t(1) << 20;
+
+    struct Columns {
+        size_t source, target, timestamp;
+    };
+    struct NodeRow {
+        std::string_view key, label, image;
+    };
+    struct EdgeRow {
+        std::string_view source, target;
+        long long timestamp;
+    };
+    struct EdgeChunk {
+        std::vector<EdgeRow> rows;
+        std::deque<std::string> owned;   // unescaped quoted fields the rows point into
+        size_t skipped = 0;
+        size_t filtered = 0;
+    };
+
+    // Buffered file output; numbers go through to_chars.
+    class Output {
     public:
-        static void toCSV(const GraphStore& store, const std::string& path) {
-            std::ofstream f(path);
-            f << "Source,Target,Timestamp\n";
-            // Logic to iterate and save...
-            f.close();
+        explicit Output(const std::string& path) : f_(std::fopen(path.c_str(), "wb")) { buf_.reserve(kBuffer); }
+        ~Output() { if (f_) close(); }
+
+        bool ok() const { return f_ != nullptr; }
+
+        Output& put(std::string_view s) {
+            if (buf_.size() + s.size() > kBuffer) drain();
+            buf_.append(s);
+            return *this;
+        }
+        Output& put(char c) {
+            if (buf_.size() == kBuffer) drain();
+            buf_.push_back(c);
+            return *this;
+        }
+        template <typename T>
+        Output& number(T v) {
+            char tmp[24];
+            auto r = std::to_chars(tmp, tmp + sizeof(tmp), v);
+            return put(std::string_view(tmp, r.ptr - tmp));
+        }
+        // Text field, quoted only when it has to be.
+        Output& field(std::string_view s, char delim) {
+            if (s.find_first_of(std::string{ delim, '"', '\n', '\r' }) == std::string_view::npos) return put(s);
+            put('"');
+            for (char c : s) {
+                if (c == '"') put('"');
+                put(c);
+            }
+            return put('"');
+        }
+
+        bool close() {
+            drain();
+            good_ = (std::fclose(f_) == 0) && good_;
+            f_ = nullptr;
+            return good_;
         }
+
+    private:
+        static constexpr size_t kBuffer = size_t(1) << 20;
+        void drain() {
+            if (!buf_.empty() && std::fwrite(buf_.data(), 1, buf_.size(), f_) != buf_.size()) good_ = false;
+            buf_.clear();
+        }
+        std::FILE* f_;
+        std::string buf_;
+        bool good_ = true;
     };
+
+    // Splits one record into fields and returns where the next one starts.
+    // Unquoted fields point into the file; a quoted field points into it too
+    // unless it holds "", in which case the unescaped copy goes to `owned`.
+    static const char* row(const char* p, const char* end, char delim, std::vector<std::string_view>& fields,
+                           std::deque<std::string>& owned) {
+        fields.clear();
+        for (;;) {
+            if (p < end && *p == '"') {
+                const char* s = ++p;
+                std::string copy;
+                bool escaped = false;
+                while (p < end) {
+                    if (*p == '"') {
+                        if (p + 1 == end || p[1] != '"') break;
+                        if (!escaped) copy.assign(s, p);
+                        escaped = true;
+                        copy.push_back('"');
+                        p += 2;
+                        continue;
+                    }
+                    if (escaped) copy.push_back(*p);
+                    ++p;
+                }
+                if (escaped) {
+                    owned.push_back(std::move(copy));
+                    fields.emplace_back(owned.back());
+                } else {
+                    fields.emplace_back(s, p - s);
+                }
+                while (p < end && *p != delim && *p != '\n') ++p;
+            } else {
+                const char* s = p;
+                while (p < end && *p != delim && *p != '\n') ++p;
+                const char* e = (p > s && p[-1] == '\r') ? p - 1 : p;
+                fields.emplace_back(s, e - s);
+            }
+            if (p >= end) return end;
+            if (*p == '\n') return p + 1;
+            ++p;
+        }
+    }
+
+    // Where the record starting at p ends, by row()'s quoting rules, without
+    // splitting it into fields.
+    static const char* skipRecord(const char* p, const char* end, char delim) {
+        for (;;) {
+            if (p < end && *p == '"') {
+                for (++p; p < end; ++p) {
+                    if (*p != '"') continue;
+                    if (p + 1 == end || p[1] != '"') break;
+                    ++p;
+                }
+            }
+            while (p < end && *p != delim && *p != '\n') ++p;
+            if (p >= end) return end;
+            if (*p == '\n') return p + 1;
+            ++p;
+        }
+    }
+
+    // lineChunks cuts after any newline, which may be inside a quoted field.
+    // If the table has a quote at all, each inner cut moves forward to the next
+    // record start, found by one serial pass over the records.
+    static void alignToRecords(const char* data, size_t size, char delim, std::vector<size_t>& cut) {
+        size_t from = cut.front();
+        if (cut.size() <= 2 || !std::memchr(data + from, '"', size - from)) return;
+        const char* p = data + from;
+        const char* end = data + size;
+        for (size_t c = 1; c + 1 < cut.size(); ++c) {
+            while (p < end && size_t(p - data) < cut[c]) p = skipRecord(p, end, delim);
+            cut[c] = p - data;
+        }
+    }
+
+    template <typename T>
+    static bool number(std::string_view s, T& out) {
+        while (!s.empty() && s.front() == ' ') s.remove_prefix(1);
+        while (!s.empty() && s.back() == ' ') s.remove_suffix(1);
+        auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+        return r.ec == std::errc() && r.ptr == s.data() + s.size();
+    }
+
+    static bool named(std::string_view field, std::initializer_list<std::string_view> names) {
+        for (auto n : names) {
+            if (field.size() != n.size()) continue;
+            bool same = true;
+            for (size_t i = 0; i < n.size() && same; ++i)
+                same = std::tolower(static_cast<unsigned char>(field[i])) == n[i];
+            if (same) return true;
+        }
+        return false;
+    }
+
+    static Columns edgeColumns(const std::vector<std::string_view>& header) {
+        Columns c{ 0, 1, 2 };
+        for (size_t i = 0; i < header.size(); ++i) {
+            if (named(header[i], { "source", "src", "from" })) c.source = i;
+            else if (named(header[i], { "target", "tgt", "to" })) c.target = i;
+            else if (named(header[i], { "timestamp", "time", "ts" })) c.timestamp = i;
+        }
+        return c;
+    }
+
+    static void parseEdges(const char* p, const char* end, char delim, Columns cols, const Options& opt, EdgeChunk& out) {
+        std::vector<std::string_view> fields;
+        size_t need = std::max({ cols.source, cols.target, cols.timestamp }) + 1;
+        while (p < end) {
+            p = row(p, end, delim, fields, out.owned);
+            if (fields.size() == 1 && fields[0].empty()) continue;
+            long long ts;
+            if (fields.size() < need || fields[cols.source].empty() || fields[cols.target].empty()
+                || !number(fields[cols.timestamp], ts)) {
+                ++out.skipped;
+                continue;
+            }
+            if (ts < opt.from || ts > opt.to) { ++out.filtered; continue; }
+            out.rows.push_back({ fields[cols.source], fields[cols.target], ts });
+        }
+    }
+
+    // Node tables are small next to edge tables, so they are parsed in one go,
+    // which also lets quoted labels span lines.
+    static void parseNodes(const char* p, const char* end, char delim, std::vector<NodeRow>& out,
+                           std::deque<std::string>& owned, size_t& skipped) {
+        std::vector<std::string_view> fields;
+        size_t id = 0, label = 1, image = 2;
+        bool first = true;
+        while (p < end) {
+            p = row(p, end, delim, fields, owned);
+            if (fields.size() == 1 && fields[0].empty()) continue;
+            if (first) {
+                first = false;
+                bool header = false;
+                for (size_t i = 0; i < fields.size(); ++i) {
+                    if (named(fields[i], { "id" })) { id = i; header = true; }
+                    else if (named(fields[i], { "label", "name" })) { label = i; header = true; }
+                    else if (named(fields[i], { "image" })) { image = i; header = true; }
+                }
+                if (header) continue;
+            }
+            if (fields.size() <= id || fields[id].empty()) { ++skipped; continue; }
+            out.push_back({ fields[id], label < fields.size() ? fields[label] : std::string_view{},
+                            image < fields.size() ? fields[image] : std::string_view{} });
+        }
+    }
+};
+
 }
@@ -0,0 +1,440 @@
+#pragma once
+#include "core/GraphStore.h"
+#include "core/MutationListener.h"
+#include "persistence/WriteAheadLog.h"
+#include "persistence/BinarySnapshot.h"
+#include "persistence/FileSync.h"
+#include "persistence/MappedFile.h"
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <charconv>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include <algorithm>
+
+namespace graph {
+
+// Durable history of one GraphStore, kept in a directory of its own:
+//   checkpoint-<gen>.bin   binary snapshot of the store at version V (in its header)
+//   wal-<gen>.log          every mutation logged since generation <gen> began
+// The journal is the store's MutationListener, so every write path (CLI, loaders,
+// the ingest queue) is logged as it is applied, at a cost proportional to the
+// change rather than to the graph. A checkpoint starts the next generation:
+// the log is rotated first, then a view is pinned and written out without
+// holding up writers, and older generations are deleted once it is on disk.
+// Records logged between the rotation and the pin carry versions <= V and are
+// already in the checkpoint, so replay skips them.
+class Journal : public MutationListener {
+public:
+    // Record bodies: a type byte, the store version, then the fields below.
+    enum RecordType : uint8_t {
+        NodesAdded = 1,     // first id, count, count x (u32 length, label bytes)
+        EdgesAdded = 2,     // count, count x (source, target, timestamp)
+        NodeRenamed = 3,    // id, u32 length, label bytes
+        NodeImageSet = 4,   // id, u32 length, path bytes
+        NodeIsolated = 5,   // id
+        Cleared = 6,
+        NodesWithImages = 7,    // first id, count, count x (label, image), each u32 length + bytes
+    };
+
+    struct Options {
+        WriteAheadLog::Options log;
+        uint64_t checkpointBytes = uint64_t(64) << 20;   // 0 = only on request
+    };
+
+    struct Stats {
+        uint64_t generation = 0;
+        uint64_t checkpointVersion = 0;
+        uint64_t checkpoints = 0;
+        uint64_t checkpointFailures = 0;
+        double lastCheckpointMs = 0;
+        WriteAheadLog::Stats log;
+    };
+
+    struct Recovery {
+        bool ok = false;
+        std::string error;
+        uint64_t generation = 0;        // checkpoint recovered from
+        uint64_t checkpointVersion = 0;
+        size_t checkpointNodes = 0;
+        size_t checkpointEdges = 0;
+        size_t logFiles = 0;
+        uint64_t replayed = 0;          // records applied on top of the checkpoint
+        uint64_t skipped = 0;           // records the checkpoint already covered
+        uint64_t discardedBytes = 0;    // torn or corrupt tail, ignored
+        double checkpointMs = 0;
+        double replayMs = 0;
+        std::string directory;
+        uint64_t version = 0;           // store version once recovered
+    };
+
+    // Rebuilds `store` from the newest readable checkpoint in `dir` plus the log
+    // records written after it. The checkpoint is mapped and bulk-restored; only
+    // the log tail is decoded. Node IDs come back as they were, and the store
+    // version at least as high as the last one logged (replay may bump it past
+    // that), so versions never repeat. Replay stops at the first record that is
+    // cut short or fails its checksum, which is where the process died mid-write.
+    // The directory is not modified; resume() a journal on it afterwards to
+    // carry on logging.
+    static Recovery recover(GraphStore& store, const std::string& dir) {
+        Recovery res;
+        res.directory = dir;
+        auto started = std::chrono::steady_clock::now();
+        std::vector<uint64_t> gens;
+        forEachFile(dir, [&](const std::filesystem::path&, uint64_t gen) { gens.push_back(gen); });
+        std::sort(gens.begin(), gens.end());
+        gens.erase(std::unique(gens.begin(), gens.end()), gens.end());
+
+        std::unique_ptr<MappedSnapshot> snap;
+        for (auto it = gens.rbegin(); it != gens.rend() && !snap; ++it) {
+            std::string ignored;
+            snap = MappedSnapshot::open(checkpointPath(dir, *it), ignored);
+            if (snap) res.generation = *it;
+        }
+        if (!snap) { res.error = "no readable checkpoint in " + dir; return res; }
+        BinarySnapshot::restore(store, *snap);
+        res.checkpointVersion = snap->storeVersion();
+        res.checkpointNodes = snap->nodeCount();
+        res.checkpointEdges = snap->edgeCount();
+        snap.reset();
+        auto restored = std::chrono::steady_clock::now();
+        res.checkpointMs = std::chrono::duration<double, std::milli>(restored - started).count();
+
+        // A log is only left with a torn tail by a crash; rotation flushes it
+        // first. If a newer log follows one, it was started by a journal opened
+        // on the state recovered up to the tear, so it replays on top as usual.
+        uint64_t last = res.checkpointVersion;
+        std::vector<EdgeRecord> pending;
+        for (uint64_t gen : gens) {
+            if (gen < res.generation) continue;
+            std::string ignored;
+            auto file = MappedFile::open(logPath(dir, gen), ignored);
+            if (!file) continue;
+            ++res.logFiles;
+            file->adviseSequential();
+            auto scan = WriteAheadLog::scan(file->data(), file->size(), [&](std::string_view body) {
+                return replay(store, body, res, last, pending);
+            });
+            res.discardedBytes += file->size() - scan.validBytes;
+        }
+        store.addEdges(pending);
+        store.advanceVersion(last);
+        res.version = store.version();
+        res.replayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - restored).count();
+        res.ok = true;
+        return res;
+    }
+
+    // Starts journaling `store` into `dir` (created if missing) with a fresh
+    // generation: a checkpoint of the store as it is now plus an empty log.
+    // A directory that already holds a journal is refused, since its history is
+    // not in the store; recover() it and resume() instead. Returns nullptr and
+    // sets `error` on failure.
+    static std::unique_ptr<Journal> open(GraphStore& store, const std::string& dir, Options opt, std::string& error) {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        if (ec) { error = "cannot create " + dir; return nullptr; }
+        if (latestGeneration(dir) != 0) {
+            error = dir + " already holds a journal; recover it or pick an empty directory";
+            return nullptr;
+        }
+        return start(store, dir, opt, 1, error);
+    }
+
+    // Carries on journaling into the directory `rec` was recovered from. The
+    // store must not have changed since, so the new checkpoint holds everything
+    // the older generations did and they can be removed once it is durable.
+    static std::unique_ptr<Journal> resume(GraphStore& store, const Recovery& rec, Options opt, std::string& error) {
+        if (!rec.ok) { error = "nothing was recovered"; return nullptr; }
+        if (store.version() != rec.version) {
+            error = "the store changed after it was recovered from " + rec.directory;
+            return nullptr;
+        }
+        return start(store, rec.directory, opt, latestGeneration(rec.directory) + 1, error);
+    }
+
+    ~Journal() override { store_.setListener(nullptr); }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Makes everything logged so far durable as the Sync policy promises, then
+    // checkpoints if the log has outgrown Options::checkpointBytes. Call it
+    // after a mutation returns, never from inside one. Returns false if the log
+    // can no longer be written.
+    bool commit() {
+        if (!log_->commit()) return false;
+        if (opt_.checkpointBytes && log_->bytes() >= opt_.checkpointBytes) {
+            std::string error;
+            checkpoint(error);
+        }
+        return true;
+    }
+
+    // Compacts the log into a new checkpoint now.
+    bool checkpoint(std::string& error) {
+        std::lock_guard<std::mutex> lk(checkpoint_mutex_);
+        uint64_t gen = generation_ + 1;
+        if (!log_->rotate(logPath(dir_, gen), error)) return fail();
+        generation_ = gen;
+        return writeCheckpoint(gen, error);
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lk(checkpoint_mutex_);
+        Stats s = stats_;
+        s.generation = generation_;
+        s.log = log_->stats();
+        return s;
+    }
+
+    const std::string& directory() const { return dir_; }
+
+    static std::string checkpointPath(const std::string& dir, uint64_t gen) { return fileName(dir, "checkpoint-", gen, ".bin"); }
+    static std::string logPath(const std::string& dir, uint64_t gen) { return fileName(dir, "wal-", gen, ".log"); }
+
+    // Highest generation with a checkpoint or log file in `dir`; 0 if none.
+    static uint64_t latestGeneration(const std::string& dir) {
+        uint64_t latest = 0;
+        forEachFile(dir, [&](const std::filesystem::path&, uint64_t gen) { latest = std::max(latest, gen); });
+        return latest;
+    }
+
+    // --- MutationListener: encode and hand to the log; no I/O happens here ---
+
+    void nodesAdded(uint64_t firstId, std::span<const std::string> labels, std::span<const std::string> images,
+                    uint64_t version) override {
+        std::string r = begin(images.empty() ? NodesAdded : NodesWithImages, version);
+        put(r, firstId);
+        put(r, uint64_t(labels.size()));
+        for (size_t i = 0; i < labels.size(); ++i) {
+            putString(r, labels[i]);
+            if (!images.empty()) putString(r, images[i]);
+        }
+        log_->append(r);
+    }
+
+    void edgesAdded(std::span<const EdgeRecord> edges, uint64_t version) override {
+        std::string r = begin(EdgesAdded, version);
+        put(r, uint64_t(edges.size()));
+        size_t at = r.size();
+        r.resize(at + edges.size() * 24);
+        for (auto const& e : edges) {
+            int64_t ts = e.timestamp;
+            std::memcpy(&r[at], &e.source, 8);
+            std::memcpy(&r[at + 8], &e.target, 8);
+            std::memcpy(&r[at + 16], &ts, 8);
+            at += 24;
+        }
+        log_->append(r);
+    }
+
+    void nodeRenamed(uint64_t id, const std::string& label, uint64_t version) override {
+        std::string r = begin(NodeRenamed, version);
+        put(r, id);
+        putString(r, label);
+        log_->append(r);
+    }
+
+    void nodeImageSet(uint64_t id, const std::string& path, uint64_t version) override {
+        std::string r = begin(NodeImageSet, version);
+        put(r, id);
+        putString(r, path);
+        log_->append(r);
+    }
+
+    void nodeIsolated(uint64_t id, uint64_t version) override {
+        std::string r = begin(NodeIsolated, version);
+        put(r, id);
+        log_->append(r);
+    }
+
+    void cleared(uint64_t version) override { log_->append(begin(Cleared, version)); }
+
+private:
+    Journal(GraphStore& store, std::string dir, Options opt, std::unique_ptr<WriteAheadLog> log, uint64_t gen)
+        : store_(store), dir_(std::move(dir)), opt_(opt), log_(std::move(log)), generation_(gen) {}
+
+    static std::unique_ptr<Journal> start(GraphStore& store, const std::string& dir, Options opt, uint64_t gen,
+                                          std::string& error) {
+        auto log = WriteAheadLog::create(logPath(dir, gen), opt.log, error);
+        if (!log) return nullptr;
+        std::unique_ptr<Journal> j(new Journal(store, dir, opt, std::move(log), gen));
+        store.setListener(j.get());
+        if (!j->writeCheckpoint(gen, error)) {
+            // Leave no half-made generation behind to be mistaken for history.
+            j.reset();
+            std::error_code ec;
+            std::filesystem::remove(logPath(dir, gen), ec);
+            return nullptr;
+        }
+        return j;
+    }
+
+    static std::string fileName(const std::string& dir, const char* prefix, uint64_t gen, const char* suffix) {
+        char num[24];
+        std::snprintf(num, sizeof(num), "%06llu", (unsigned long long)gen);
+        return dir + "/" + prefix + num + suffix;
+    }
+
+    // Calls fn(path, generation) for each journal file in `dir`, stray .tmp files included.
+    template <typename Fn>
+    static void forEachFile(const std::string& dir, Fn&& fn) {
+        std::error_code ec;
+        for (auto const& entry : std::filesystem::directory_iterator(dir, ec)) {
+            std::string name = entry.path().filename().string();
+            std::string_view rest;
+            if (name.rfind("checkpoint-", 0) == 0) rest = std::string_view(name).substr(11);
+            else if (name.rfind("wal-", 0) == 0) rest = std::string_view(name).substr(4);
+            else continue;
+            uint64_t gen;
+            auto r = std::from_chars(rest.data(), rest.data() + rest.size(), gen);
+            if (r.ec != std::errc() || r.ptr == rest.data() || *r.ptr != '.') continue;
+            fn(entry.path(), gen);
+        }
+    }
+
+    // Reads a record body front to back; every getter fails rather than overrun.
+    struct Decoder {
+        std::string_view body;
+        size_t at = 0;
+
+        template <typename T>
+        bool get(T& v) {
+            if (body.size() - at < sizeof(T)) return false;
+            std::memcpy(&v, body.data() + at, sizeof(T));
+            at += sizeof(T);
+            return true;
+        }
+        bool getString(std::string& s) {
+            uint32_t len;
+            if (!get(len) || body.size() - at < len) return false;
+            s.assign(body.data() + at, len);
+            at += len;
+            return true;
+        }
+        bool done() const { return at == body.size(); }
+    };
+
+    // Applies one logged mutation unless the checkpoint already holds it.
+    // Returns false for a body that does not decode. Runs of edge records are
+    // gathered in `pending` and inserted as one batch before the next record of
+    // another kind, which gives the same graph as inserting them one by one.
+    static bool replay(GraphStore& store, std::string_view body, Recovery& res, uint64_t& last,
+                       std::vector<EdgeRecord>& pending) {
+        Decoder d{ body };
+        uint8_t type;
+        uint64_t version, id, count;
+        if (!d.get(type) || !d.get(version)) return false;
+        if (version <= res.checkpointVersion) {
+            ++res.skipped;
+            return true;
+        }
+        if (type != EdgesAdded && !pending.empty()) {
+            store.addEdges(pending);
+            pending.clear();
+        }
+        std::string text;
+        switch (type) {
+        case NodesAdded:
+        case NodesWithImages: {
+            if (!d.get(id) || !d.get(count) || count > body.size() / 4) return false;
+            bool withImages = type == NodesWithImages;
+            std::vector<uint64_t> ids(count);
+            std::vector<std::string> labels(count), images(withImages ? count : 0);
+            for (uint64_t i = 0; i < count; ++i) {
+                ids[i] = id + i;
+                if (!d.getString(labels[i]) || (withImages && !d.getString(images[i]))) return false;
+            }
+            if (!d.done()) return false;
+            store.restoreNodes(ids, labels, images);
+            break;
+        }
+        case EdgesAdded: {
+            if (!d.get(count) || count != (body.size() - d.at) / 24 || (body.size() - d.at) % 24) return false;
+            for (uint64_t i = 0; i < count; ++i) {
+                EdgeRecord e;
+                int64_t ts;
+                if (!d.get(e.source) || !d.get(e.target) || !d.get(ts)) return false;
+                e.timestamp = ts;
+                pending.push_back(e);
+            }
+            break;
+        }
+        case NodeRenamed:
+        case NodeImageSet:
+            if (!d.get(id) || !d.getString(text) || !d.done()) return false;
+            if (type == NodeRenamed) store.renameNode(id, std::move(text));
+            else store.setNodeImage(id, std::move(text));
+            break;
+        case NodeIsolated:
+            if (!d.get(id) || !d.done()) return false;
+            store.isolateNode(id);
+            break;
+        case Cleared:
+            if (!d.done()) return false;
+            store.clear();
+            break;
+        default:
+            return false;
+        }
+        ++res.replayed;
+        last = std::max(last, version);
+        return true;
+    }
+
+    // Caller holds checkpoint_mutex_ (or is start(), before anyone else can see the journal).
+    bool writeCheckpoint(uint64_t gen, std::string& error) {
+        auto started = std::chrono::steady_clock::now();
+        GraphView view = store_.pin(true);
+        std::string path = checkpointPath(dir_, gen);
+        if (!BinarySnapshot::save(view, path)) {
+            error = "cannot write " + path;
+            return fail();
+        }
+        std::error_code ec;
+        forEachFile(dir_, [&](const std::filesystem::path& p, uint64_t g) {
+            if (g < gen) std::filesystem::remove(p, ec);
+        });
+        FileSync::directoryOf(path);
+        ++stats_.checkpoints;
+        stats_.checkpointVersion = view.version();
+        stats_.lastCheckpointMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        return true;
+    }
+
+    bool fail() {
+        ++stats_.checkpointFailures;
+        return false;
+    }
+
+    static std::string begin(RecordType type, uint64_t version) {
+        std::string r(1, char(type));
+        put(r, version);
+        return r;
+    }
+
+    template <typename T>
+    static void put(std::string& r, T v) { r.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+    static void putString(std::string& r, const std::string& s) {
+        put(r, uint32_t(s.size()));
+        r += s;
+    }
+
+    GraphStore& store_;
+    std::string dir_;
+    Options opt_;
+    std::unique_ptr<WriteAheadLog> log_;
+    mutable std::mutex checkpoint_mutex_;
+    uint64_t generation_;
+    Stats stats_;
+};
+
+}
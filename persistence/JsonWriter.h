@@ -0,0 +1,156 @@
+#pragma once
+#include "core/GraphStore.h"
+#include <string>
+#include <string_view>
+#include <functional>
+#include <memory>
+#include <cstring>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <climits>
+
+namespace graph {
+
+// Buffered JSON text output. Values are formatted straight into one large
+// buffer (numbers with std::to_chars, strings escaped per RFC 8259) and handed
+// to the sink only when it fills, so a multi-million element document costs a
+// few hundred sink calls. The sink decides where the bytes go: a FILE* (a file
+// or stdout), a string (an HTTP response body), or any callback, e.g. a chunked
+// HTTP writer. Structure (commas, brackets) is the caller's job.
+class JsonWriter {
+public:
+    // Receives each full buffer; returns false to report a write error.
+    using Sink = std::function<bool(const char* data, size_t size)>;
+
+    explicit JsonWriter(Sink sink, size_t bufferBytes = size_t(1) << 20)
+        : sink_(std::move(sink)), capacity_(bufferBytes < 64 ? 64 : bufferBytes) {
+        buf_.reset(new char[capacity_]);
+    }
+
+    // Writes to `f` (not closed). Pass stdout to stream to the console.
+    static JsonWriter toFile(std::FILE* f) {
+        return JsonWriter([f](const char* d, size_t n) { return std::fwrite(d, 1, n, f) == n; });
+    }
+
+    // Appends to `out`, e.g. the body of an HTTP response.
+    static JsonWriter toString(std::string& out) {
+        return JsonWriter([&out](const char* d, size_t n) { out.append(d, n); return true; });
+    }
+
+    JsonWriter(JsonWriter&&) = default;
+    ~JsonWriter() { if (buf_) flush(); }
+
+    JsonWriter& raw(std::string_view s) {
+        if (s.size() > capacity_ - used_) {
+            flush();
+            if (s.size() > capacity_) { ok_ = sink_(s.data(), s.size()) && ok_; return *this; }
+        }
+        std::memcpy(buf_.get() + used_, s.data(), s.size());
+        used_ += s.size();
+        return *this;
+    }
+
+    JsonWriter& raw(char c) {
+        if (used_ == capacity_) flush();
+        buf_[used_++] = c;
+        return *this;
+    }
+
+    // Integer or floating-point value.
+    template <typename T>
+    JsonWriter& number(T v) {
+        if (capacity_ - used_ < 32) flush();
+        auto r = std::to_chars(buf_.get() + used_, buf_.get() + capacity_, v);
+        used_ = r.ptr - buf_.get();
+        return *this;
+    }
+
+    // Quoted, escaped string value. Bytes >= 0x80 pass through, so UTF-8 labels survive.
+    JsonWriter& string(std::string_view s) {
+        raw('"');
+        size_t run = 0;
+        for (size_t i = 0; i < s.size(); ++i) {
+            unsigned char c = s[i];
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            raw(s.substr(run, i - run));
+            run = i + 1;
+            switch (c) {
+            case '"': raw("\\\""); break;
+            case '\\': raw("\\\\"); break;
+            case '\n': raw("\\n"); break;
+            case '\r': raw("\\r"); break;
+            case '\t': raw("\\t"); break;
+            case '\b': raw("\\b"); break;
+            case '\f': raw("\\f"); break;
+            default: {
+                static const char hex[] = "0123456789abcdef";
+                char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+                raw(std::string_view(esc, 6));
+            }
+            }
+        }
+        raw(s.substr(run));
+        return raw('"');
+    }
+
+    // Hands everything buffered to the sink. Returns false if any write so far failed.
+    bool flush() {
+        if (used_) ok_ = sink_(buf_.get(), used_) && ok_;
+        used_ = 0;
+        return ok_;
+    }
+
+    bool ok() const { return ok_; }
+
+private:
+    Sink sink_;
+    std::unique_ptr<char[]> buf_;
+    size_t capacity_;
+    size_t used_ = 0;
+    bool ok_ = true;
+};
+
+// The dashboard's graph document:
+//   {"nodes":[{"id":..,"label":"..","image":".."},...],"edges":[{"from":..,"to":..,"ts":..},...]}
+// Nodes and edges come from one view pinned with its node data, so the document
+// is the graph at a single version: a concurrent writer can neither leave an
+// edge pointing at a node the document lacks nor hold up the export.
+class GraphJson {
+public:
+    static bool write(JsonWriter& out, const GraphStore& store, long long from = LLONG_MIN, long long to = LLONG_MAX) {
+        GraphView view = store.pin(true);
+        return write(out, view, from, to);
+    }
+
+    // `view` must come from pin(true).
+    static bool write(JsonWriter& out, GraphView& view, long long from = LLONG_MIN, long long to = LLONG_MAX) {
+        out.raw("{\"nodes\":[");
+        const std::vector<uint64_t>& ids = view.nodeIds();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            out.raw(i ? ",{\"id\":" : "{\"id\":").number(ids[i]);
+            out.raw(",\"label\":").string(view.label(i));
+            out.raw(",\"image\":").string(view.image(i)).raw('}');
+        }
+        out.raw("],\"edges\":[");
+        bool first = true;
+        view.forEachEdgeInRange(from, to, [&](uint64_t src, uint64_t tgt, long long ts) {
+            out.raw(first ? "{\"from\":" : ",{\"from\":").number(src);
+            out.raw(",\"to\":").number(tgt);
+            out.raw(",\"ts\":").number(ts).raw('}');
+            first = false;
+        });
+        out.raw("]}");
+        return out.flush();
+    }
+
+    // Whole document as a string, for an HTTP response body.
+    static std::string toString(const GraphStore& store, long long from = LLONG_MIN, long long to = LLONG_MAX) {
+        std::string body;
+        JsonWriter out = JsonWriter::toString(body);
+        write(out, store, from, to);
+        return body;
+    }
+};
+
+}
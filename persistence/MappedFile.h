@@ -0,0 +1,74 @@
+#pragma once
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace graph {
+
+// Read-only memory mapping of a whole file, unmapped on destruction.
+class MappedFile {
+public:
+    // Returns nullptr and sets `error` if the file cannot be opened or mapped.
+    // An empty file maps to a valid object with size() == 0.
+    static std::unique_ptr<MappedFile> open(const std::string& path, std::string& error) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open " + path; return nullptr; }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            error = "cannot stat " + path;
+            return nullptr;
+        }
+        size_t size = st.st_size;
+        void* base = nullptr;
+        if (size > 0) {
+            base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                ::close(fd);
+                error = "cannot map " + path;
+                return nullptr;
+            }
+        }
+        ::close(fd);
+        return std::unique_ptr<MappedFile>(new MappedFile(static_cast<const char*>(base), size));
+    }
+
+    ~MappedFile() { if (data_) munmap(const_cast<char*>(data_), size_); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Tells the kernel the file will be read front to back (more read-ahead).
+    void adviseSequential() const { if (data_) madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL); }
+
+    // Cuts the file into up to `maxChunks` pieces of at least `minChunk` bytes,
+    // each ending just after a newline (or at end of file), for parallel line
+    // parsers. Returns the boundaries: chunk c is [cut[c], cut[c + 1]).
+    std::vector<size_t> lineChunks(size_t minChunk, size_t maxChunks) const {
+        size_t chunks = std::max<size_t>(1, std::min(size_ / std::max<size_t>(minChunk, 1), maxChunks));
+        std::vector<size_t> cut(chunks + 1, size_);
+        cut[0] = 0;
+        for (size_t c = 1; c < chunks; ++c) {
+            size_t pos = std::max(size_ * c / chunks, cut[c - 1]);
+            while (pos < size_ && data_[pos - 1] != '\n') ++pos;
+            cut[c] = pos;
+        }
+        return cut;
+    }
+
+private:
+    MappedFile(const char* data, size_t size) : data_(data), size_(size) {}
+
+    const char* data_;
+    size_t size_;
+};
+
+}
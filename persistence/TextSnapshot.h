@@ -0,0 +1,172 @@
+#pragma once
+#include "core/GraphStore.h"
+#include "persistence/MappedFile.h"
+#include "concurrency/WorkStealing.h"
+#include <string>
+#include <vector>
+#include <charconv>
+#include <unordered_map>
+#include <cstdint>
+
+namespace graph {
+
+// Loader for the text snapshot format written by `save`:
+//   NODE <id> "<label>" "<image>"
+//   EDGE <u> <v> <timestamp>
+// The file is memory-mapped and cut into line-aligned chunks that are parsed
+// concurrently with std::from_chars; the chunk results are concatenated in file
+// order and inserted with one addNodes (images included) and one addEdges call.
+// The outcome is the same as reading the file line by line: nodes get fresh
+// store IDs in file order, a repeated file ID maps to its last NODE line, and
+// edges naming an unknown file ID attach to the first loaded node, as with
+// BinarySnapshot::load. A file with edges but no nodes is refused.
+class TextSnapshot {
+public:
+    struct Result {
+        bool ok = false;
+        std::string error;
+        size_t nodes = 0;
+        size_t edges = 0;
+        size_t skipped = 0;     // NODE/EDGE lines with a missing or malformed number
+    };
+
+    // Replaces the store's contents with the file's. The store is left untouched
+    // if the file cannot be read or is refused. threads == 0 uses every core.
+    static Result load(GraphStore& store, const std::string& path, unsigned threads = 0) {
+        Result res;
+        auto file = MappedFile::open(path, res.error);
+        if (!file) return res;
+        file->adviseSequential();
+
+        const char* data = file->data();
+        if (threads == 0) threads = WorkStealing::defaultThreads();
+        std::vector<size_t> cut = file->lineChunks(kMinChunk, size_t(threads) * 4);
+        size_t chunks = cut.size() - 1;
+
+        std::vector<Chunk> parsed(chunks);
+        WorkStealing::run(chunks, threads, 1, [&](size_t b, size_t e, unsigned) {
+            for (size_t c = b; c < e; ++c) parseChunk(data + cut[c], data + cut[c + 1], parsed[c]);
+        });
+
+        std::vector<std::string> labels, images;
+        std::vector<size_t> edgeStart(chunks + 1, 0);
+        for (size_t c = 0; c < chunks; ++c) {
+            res.nodes += parsed[c].nodes.size();
+            res.skipped += parsed[c].skipped;
+            edgeStart[c + 1] = edgeStart[c] + parsed[c].edges.size();
+        }
+        // Unknown endpoints go to the first loaded node; there must be one.
+        if (res.nodes == 0 && edgeStart[chunks] > 0) {
+            res.error = "snapshot has edges but no nodes";
+            res.skipped = 0;
+            return res;
+        }
+        labels.reserve(res.nodes);
+        images.reserve(res.nodes);
+        for (auto& chunk : parsed)
+            for (auto& n : chunk.nodes) {
+                labels.push_back(std::move(n.label));
+                // "" keeps the default, and a journal need not log it per node
+                images.push_back(n.image == "default.png" ? std::string() : std::move(n.image));
+            }
+
+        store.clear();
+        uint64_t first = store.addNodes(labels, images);
+        std::unordered_map<uint64_t, uint64_t> idMap;
+        idMap.reserve(res.nodes);
+        uint64_t rid = first;
+        for (auto& chunk : parsed)
+            for (auto& n : chunk.nodes) idMap[n.fileId] = rid++;
+
+        res.edges = edgeStart[chunks];
+        std::vector<EdgeRecord> edges(res.edges);
+        WorkStealing::run(chunks, threads, 1, [&](size_t b, size_t e, unsigned) {
+            auto remap = [&](uint64_t fid) {
+                auto it = idMap.find(fid);
+                return it == idMap.end() ? first : it->second;
+            };
+            for (size_t c = b; c < e; ++c) {
+                EdgeRecord* out = edges.data() + edgeStart[c];
+                for (auto const& r : parsed[c].edges) *out++ = { remap(r.source), remap(r.target), r.timestamp };
+            }
+        });
+        store.addEdges(edges);
+        res.ok = true;
+        return res;
+    }
+
+private:
+    static constexpr size_t kMinChunk = size_t(1) << 20;
+
+    struct NodeRec {
+        uint64_t fileId;
+        std::string label;
+        std::string image;
+    };
+    struct Chunk {
+        std::vector<NodeRec> nodes;
+        std::vector<EdgeRecord> edges;   // still in file IDs
+        size_t skipped = 0;
+    };
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+    // Next token on the line: a "quoted string" with backslash escapes, or a run of
+    // non-space characters. Leaves `out` empty at end of line.
+    static void token(const char*& p, const char* end, std::string& out) {
+        out.clear();
+        while (p < end && isSpace(*p)) ++p;
+        if (p == end) return;
+        if (*p == '"') {
+            ++p;
+            while (p < end) {
+                char c = *p++;
+                if (c == '\\' && p < end) out.push_back(*p++);
+                else if (c == '"') break;
+                else out.push_back(c);
+            }
+        } else {
+            const char* s = p;
+            while (p < end && !isSpace(*p)) ++p;
+            out.assign(s, p);
+        }
+    }
+
+    template <typename T>
+    static bool number(const char*& p, const char* end, T& out) {
+        while (p < end && isSpace(*p)) ++p;
+        auto r = std::from_chars(p, end, out);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+
+    static void parseChunk(const char* p, const char* end, Chunk& out) {
+        std::string typ;
+        while (p < end) {
+            const char* eol = p;
+            while (eol < end && *eol != '\n') ++eol;
+            const char* q = p;
+            p = (eol < end) ? eol + 1 : end;
+            if (q == eol || *q == '#') continue;
+
+            token(q, eol, typ);
+            if (typ == "NODE") {
+                NodeRec n;
+                if (!number(q, eol, n.fileId)) { ++out.skipped; continue; }
+                token(q, eol, n.label);
+                token(q, eol, n.image);
+                out.nodes.push_back(std::move(n));
+            } else if (typ == "EDGE") {
+                EdgeRecord e;
+                if (!number(q, eol, e.source) || !number(q, eol, e.target) || !number(q, eol, e.timestamp)) {
+                    ++out.skipped;
+                    continue;
+                }
+                out.edges.push_back(e);
+            }
+        }
+    }
+};
+
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include "persistence/Crc32.h"
+#include "persistence/FileSync.h"
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace graph {
+
+// Append-only file of opaque records. After a 16-byte file header each record is
+//   uint32_t length | uint32_t crc32c(body) | body[length]
+// append() only copies the record into a memory buffer; a background thread
+// writes the buffer out, so every record appended while one write is in flight
+// shares the next write and fsync (group commit). The Sync policy decides when a
+// record is durable:
+//   Always    commit() waits until the record is on disk
+//   Interval  the file is fsynced every `interval`; commit() does not wait
+//   Never     the buffer is written every `interval`, syncing is left to the OS
+class WriteAheadLog {
+public:
+    enum class Sync { Always, Interval, Never };
+
+    struct Options {
+        Sync sync = Sync::Always;
+        std::chrono::milliseconds interval{ 20 };
+    };
+
+    struct Stats {
+        uint64_t records = 0;
+        uint64_t bytes = 0;     // current file, header and buffered records included
+        uint64_t writes = 0;
+        uint64_t fsyncs = 0;
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+    };
+
+    static constexpr char kMagic[8] = { 'G', 'F', 'E', 'W', 'A', 'L', 0, 0 };
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrder = 0x01020304;
+    static constexpr size_t kFrameBytes = 8;
+
+    // Creates (or truncates) the file at `path`. Returns nullptr and sets `error` on failure.
+    static std::unique_ptr<WriteAheadLog> create(const std::string& path, Options opt, std::string& error) {
+        int fd = openFile(path, error);
+        if (fd < 0) return nullptr;
+        return std::unique_ptr<WriteAheadLog>(new WriteAheadLog(fd, opt));
+    }
+
+    // Writes out what is buffered and closes the file.
+    ~WriteAheadLog() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        flusher_.join();
+        flush(opt_.sync != Sync::Never);
+        ::close(fd_);
+    }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Safe from any thread and never waits for I/O. Returns the record's
+    // sequence number, counting from 1 across rotations.
+    uint64_t append(std::string_view body) {
+        uint32_t len = static_cast<uint32_t>(body.size());
+        uint32_t crc = Crc32::compute(body.data(), body.size());
+        std::lock_guard<std::mutex> lk(m_);
+        size_t at = buf_.size();
+        buf_.resize(at + kFrameBytes + body.size());
+        std::memcpy(&buf_[at], &len, 4);
+        std::memcpy(&buf_[at + 4], &crc, 4);
+        std::memcpy(&buf_[at + kFrameBytes], body.data(), body.size());
+        if (buf_.size() >= kFlushBytes) wake_.notify_one();
+        return ++appended_;
+    }
+
+    // Under Sync::Always, waits until record `seq` and everything before it is
+    // on disk. Returns false once the log has failed to write.
+    bool commit(uint64_t seq) {
+        std::unique_lock<std::mutex> lk(m_);
+        if (opt_.sync == Sync::Always && durable_ < seq && !failed_) {
+            ++waiters_;
+            wake_.notify_one();
+            done_.wait(lk, [&] { return durable_ >= seq || failed_; });
+            --waiters_;
+        }
+        return !failed_;
+    }
+
+    bool commit() { return commit(lastSequence()); }
+
+    uint64_t lastSequence() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return appended_;
+    }
+
+    // Writes and syncs every record appended so far to the current file, then
+    // continues in a new file at `path`; later appends land there. On failure
+    // the current file stays in use.
+    bool rotate(const std::string& path, std::string& error) {
+        int fd = openFile(path, error);
+        if (fd < 0) return false;
+        std::lock_guard<std::mutex> io(io_);
+        if (!flushLocked(true)) {
+            ::close(fd);
+            error = "cannot write log";
+            return false;
+        }
+        ::close(fd_);
+        fd_ = fd;
+        std::lock_guard<std::mutex> lk(m_);
+        stats_.bytes = sizeof(FileHeader);
+        return true;
+    }
+
+    // Bytes in the current file, counting records not yet written out.
+    uint64_t bytes() const {
+        std::lock_guard<std::mutex> lk(m_);
+        return stats_.bytes + buf_.size();
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lk(m_);
+        Stats s = stats_;
+        s.records = appended_;
+        s.bytes += buf_.size();
+        return s;
+    }
+
+    struct Scan {
+        bool header = false;        // the file starts with a log header this build reads
+        uint64_t records = 0;
+        uint64_t validBytes = 0;    // header plus the whole, intact records after it
+    };
+
+    // Walks a log file image, calling fn(body) for each whole record whose
+    // checksum matches. Stops at the first record that is cut short, fails its
+    // checksum or is rejected by fn (returns false); everything from there on is
+    // a torn or corrupt tail.
+    template <typename Fn>
+    static Scan scan(const char* data, size_t size, Fn&& fn) {
+        Scan res;
+        FileHeader h;
+        if (size < sizeof(h)) return res;
+        std::memcpy(&h, data, sizeof(h));
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion || h.byteOrder != kByteOrder)
+            return res;
+        res.header = true;
+        size_t at = sizeof(h);
+        while (size - at >= kFrameBytes) {
+            uint32_t len, crc;
+            std::memcpy(&len, data + at, 4);
+            std::memcpy(&crc, data + at + 4, 4);
+            if (len > size - at - kFrameBytes) break;
+            std::string_view body(data + at + kFrameBytes, len);
+            if (Crc32::compute(body.data(), body.size()) != crc || !fn(body)) break;
+            at += kFrameBytes + len;
+            ++res.records;
+        }
+        res.validBytes = at;
+        return res;
+    }
+
+private:
+    static constexpr size_t kFlushBytes = size_t(1) << 20;
+
+    WriteAheadLog(int fd, Options opt) : opt_(opt), fd_(fd) {
+        stats_.bytes = sizeof(FileHeader);
+        flusher_ = std::thread([this] { flushLoop(); });
+    }
+
+    static int openFile(const std::string& path, std::string& error) {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) { error = "cannot create " + path; return -1; }
+        FileHeader h{};
+        std::memcpy(h.magic, kMagic, sizeof(h.magic));
+        h.version = kVersion;
+        h.byteOrder = kByteOrder;
+        if (!FileSync::writeAll(fd, reinterpret_cast<const char*>(&h), sizeof(h)) || fsync(fd) != 0
+            || !FileSync::directoryOf(path)) {
+            ::close(fd);
+            error = "cannot write " + path;
+            return -1;
+        }
+        return fd;
+    }
+
+    void flushLoop() {
+        std::unique_lock<std::mutex> lk(m_);
+        while (!stop_) {
+            wake_.wait_for(lk, opt_.interval, [&] {
+                return stop_ || (!buf_.empty() && (waiters_ > 0 || buf_.size() >= kFlushBytes));
+            });
+            if (stop_ || buf_.empty()) continue;
+            lk.unlock();
+            flush(opt_.sync != Sync::Never);
+            lk.lock();
+        }
+    }
+
+    bool flush(bool sync) {
+        std::lock_guard<std::mutex> io(io_);
+        return flushLocked(sync);
+    }
+
+    // Caller holds io_, which keeps the file from being swapped mid-write.
+    bool flushLocked(bool sync) {
+        uint64_t upto;
+        out_.clear();
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            out_.swap(buf_);
+            upto = appended_;
+            if (failed_) return false;
+        }
+        bool ok = FileSync::writeAll(fd_, out_.data(), out_.size()) && (!sync || fdatasync(fd_) == 0);
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (ok) {
+                durable_ = upto;
+                stats_.bytes += out_.size();
+                if (!out_.empty()) ++stats_.writes;
+                if (sync) ++stats_.fsyncs;
+            } else {
+                failed_ = true;
+            }
+        }
+        done_.notify_all();
+        return ok;
+    }
+
+    Options opt_;
+    int fd_;                        // guarded by io_
+    std::string out_;               // guarded by io_; swapped with buf_ to reuse capacity
+    std::mutex io_;                 // taken before m_
+    mutable std::mutex m_;
+    std::condition_variable wake_;  // flusher: work to do
+    std::condition_variable done_;  // committers: durable_ moved
+    std::string buf_;
+    uint64_t appended_ = 0;
+    uint64_t durable_ = 0;
+    unsigned waiters_ = 0;
+    bool failed_ = false;
+    bool stop_ = false;
+    Stats stats_;
+    std::thread flusher_;
+};
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+// Minimal harness shared by the regression tests: each tests/*.cpp is its own
+// binary holding TEST(name) { ... CHECK(cond); ... } blocks; main runs them all
+// and exits non-zero if any check failed.
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace check {
+
+struct Case { const char* name; void (*fn)(); };
+
+inline std::vector<Case>& cases() { static std::vector<Case> all; return all; }
+inline int& failures() { static int n = 0; return n; }
+
+struct Register {
+    Register(const char* name, void (*fn)()) { cases().push_back({ name, fn }); }
+};
+
+// Fresh scratch directory for tests that write files; removeDir() it after.
+inline std::string tempDir() {
+    char tmpl[] = "/tmp/graph-test-XXXXXX";
+    const char* d = mkdtemp(tmpl);
+    if (!d) { std::perror("mkdtemp"); std::exit(2); }
+    return d;
+}
+
+inline void removeDir(const std::string& dir) {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+}
+
+#define TEST(name) \
+    static void name(); \
+    static check::Register name##_registered(#name, name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "  FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            ++check::failures(); \
+        } \
+    } while (0)
+
+int main() {
+    for (auto const& c : check::cases()) {
+        int before = check::failures();
+        c.fn();
+        std::printf("%s %s\n", check::failures() == before ? "ok  " : "FAIL", c.name);
+    }
+    return check::failures() ? 1 : 0;
+}
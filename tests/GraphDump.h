@@ -0,0 +1,27 @@
+#pragma once
+// Store contents in a form that survives ID remapping, for round-trip tests.
+// Nodes are keyed by label, so fixtures must use distinct labels.
+#include "core/GraphStore.h"
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <climits>
+
+struct GraphDump {
+    std::map<std::string, std::string> images;                          // label -> image
+    std::multiset<std::tuple<std::string, std::string, long long>> edges;  // labels and timestamp
+
+    static GraphDump of(const graph::GraphStore& store) {
+        GraphDump d;
+        store.forEachNode([&](const graph::Node& n) { d.images[n.label()] = n.image(); });
+        std::map<uint64_t, std::string> labels;
+        store.forEachNode([&](const graph::Node& n) { labels[n.id()] = n.label(); });
+        store.forEachEdgeInRange(LLONG_MIN, LLONG_MAX, [&](const graph::Edge& e) {
+            d.edges.insert({ labels[e.source()], labels[e.target()], e.timestamp() });
+        });
+        return d;
+    }
+
+    bool operator==(const GraphDump& o) const { return images == o.images && edges == o.edges; }
+};
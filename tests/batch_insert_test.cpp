@@ -0,0 +1,98 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include <random>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <climits>
+
+using namespace graph;
+
+namespace {
+
+using Row = std::tuple<uint64_t, uint64_t, long long>;
+
+std::vector<Row> timeline(const GraphStore& s) {
+    std::vector<Row> out;
+    s.forEachEdgeInRange(LLONG_MIN, LLONG_MAX, [&](const Edge& e) { out.push_back({ e.source(), e.target(), e.timestamp() }); });
+    return out;
+}
+
+std::vector<Row> incident(const GraphStore& s, uint64_t id) {
+    std::vector<Row> out;
+    for (auto const& e : s.getIncidentEdges(id)) out.push_back({ e.source(), e.target(), e.timestamp() });
+    return out;
+}
+
+// Every index the store keeps, compared node by node and pair by pair.
+bool sameState(GraphStore& a, GraphStore& b, uint64_t nodes) {
+    if (a.edgeCount() != b.edgeCount() || timeline(a) != timeline(b)) return false;
+    for (uint64_t u = 0; u < nodes; ++u) {
+        if (incident(a, u) != incident(b, u) || a.getNeighbors(u) != b.getNeighbors(u)) return false;
+        auto ca = a.getDegreeCounts(u), cb = b.getDegreeCounts(u);
+        if (ca.total != cb.total || ca.distinct != cb.distinct || ca.windowed != cb.windowed) return false;
+        for (uint64_t v = u; v < nodes; ++v)
+            if (a.getAllTimestamps(u, v) != b.getAllTimestamps(u, v)) return false;
+    }
+    for (auto m : { DegreeIndex::Metric::Total, DegreeIndex::Metric::Distinct, DegreeIndex::Metric::Windowed })
+        if (a.topByDegree(m, 10) != b.topByDegree(m, 10)) return false;
+    auto ga = a.freeze(), gb = b.freeze();
+    for (uint32_t v = 0; v < ga->nodeCount(); ++v) {
+        auto na = ga->neighbors(v), nb = gb->neighbors(v);
+        if (!std::equal(na.begin(), na.end(), nb.begin(), nb.end())) return false;
+    }
+    return true;
+}
+
+}
+
+// One addEdges call leaves the store exactly as the same edges added one at a
+// time: shuffled timestamps, ties, repeats and self-loops included.
+TEST(addEdgesMatchesAddEdge) {
+    const uint64_t nodes = 40;
+    std::mt19937 rng(3);
+    std::vector<EdgeRecord> batch;
+    for (int i = 0; i < 3000; ++i)
+        batch.push_back({ rng() % nodes, rng() % nodes, 1000 + (long long)(rng() % 400) });
+
+    GraphStore one, many;
+    std::vector<std::string> labels(nodes, "n");
+    one.addNodes(labels);
+    many.addNodes(labels);
+    for (auto const& r : batch) one.addEdge(r.source, r.target, r.timestamp);
+    many.addEdges(batch);
+    CHECK(sameState(one, many, nodes));
+}
+
+// Batches land behind, between and ahead of what the store already holds.
+TEST(batchesInterleaveWithExistingEdges) {
+    const uint64_t nodes = 12;
+    std::mt19937 rng(5);
+    GraphStore one, many;
+    std::vector<std::string> labels(nodes, "n");
+    one.addNodes(labels);
+    many.addNodes(labels);
+    for (int round = 0; round < 20; ++round) {
+        std::vector<EdgeRecord> batch;
+        for (int i = 0; i < 50; ++i) batch.push_back({ rng() % nodes, rng() % nodes, (long long)(rng() % 1000) });
+        for (auto const& r : batch) one.addEdge(r.source, r.target, r.timestamp);
+        many.addEdges(batch);
+        if (round % 5 == 4) {
+            one.isolateNode(round % nodes);
+            many.isolateNode(round % nodes);
+        }
+    }
+    CHECK(sameState(one, many, nodes));
+}
+
+TEST(addNodesMatchesAddNode) {
+    GraphStore one, many;
+    std::vector<std::string> labels = { "a", "b", "", "d d" };
+    for (auto const& l : labels) one.addNode(l);
+    uint64_t first = many.addNodes(labels);
+    CHECK(first == 0);
+    CHECK(many.nodeCount() == one.nodeCount());
+    for (uint64_t id = 0; id < labels.size(); ++id) CHECK(many.getNodeLabel(id) == one.getNodeLabel(id));
+    CHECK(many.addNode("e") == one.addNode("e"));
+    CHECK(many.addNodes({}) == 5);
+}
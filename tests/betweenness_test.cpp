@@ -0,0 +1,98 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/Betweenness.h"
+#include <random>
+#include <vector>
+#include <string>
+#include <cmath>
+
+using namespace graph;
+
+namespace {
+
+constexpr double kTol = 1e-9;
+
+// Normalised betweenness of the i-th of n vertices on a path: every pair with
+// one end on each side goes through it.
+double pathScore(size_t i, size_t n) {
+    return double(i) * double(n - 1 - i) / (double(n - 1) * double(n - 2) / 2.0);
+}
+
+// Connected enough that most pairs have several shortest paths.
+std::shared_ptr<const CsrSnapshot> randomGraph(GraphStore& store, size_t n) {
+    std::vector<std::string> labels(n, "n");
+    store.addNodes(labels);
+    std::mt19937 rng(11);
+    std::vector<EdgeRecord> edges;
+    for (uint64_t v = 1; v < n; ++v) edges.push_back({ rng() % v, v, 1 });
+    for (size_t i = 0; i < 2 * n; ++i) edges.push_back({ rng() % n, rng() % n, 2 });
+    store.addEdges(edges);
+    return store.freeze();
+}
+
+}
+
+TEST(exactOnAPath) {
+    GraphStore store;
+    const size_t n = 9;
+    std::vector<std::string> labels(n, "n");
+    store.addNodes(labels);
+    for (uint64_t v = 1; v < n; ++v) store.addEdge(v - 1, v, v);
+    store.addEdge(3, 4, 100);       // repeated contact: still one hop
+    auto g = store.freeze();
+
+    for (unsigned threads : { 1u, 4u }) {
+        BetweennessOptions opt;
+        opt.threads = threads;
+        auto r = Betweenness::compute(*g, opt);
+        CHECK(r.exact && r.sources == n);
+        for (uint32_t v = 0; v < n; ++v)
+            CHECK(std::fabs(r.score[v] - pathScore(g->idOf(v), n)) < kTol);
+        CHECK(g->idOf(r.top(1)[0].first) == 4);
+    }
+}
+
+TEST(exactOnAStar) {
+    GraphStore store;
+    std::vector<std::string> labels(7, "n");
+    store.addNodes(labels);
+    for (uint64_t v = 1; v < 7; ++v) store.addEdge(0, v, v);
+    auto g = store.freeze();
+    auto r = Betweenness::compute(*g);
+    CHECK(std::fabs(r.score[g->indexOf(0)] - 1.0) < kTol);
+    for (uint64_t v = 1; v < 7; ++v) CHECK(std::fabs(r.score[g->indexOf(v)]) < kTol);
+
+    // A chord between two leaves splits their pair between hub and direct edge.
+    store.addEdge(1, 2, 10);
+    g = store.freeze();
+    r = Betweenness::compute(*g);
+    CHECK(std::fabs(r.score[g->indexOf(0)] - 14.0 / 15.0) < kTol);
+}
+
+TEST(sampledWithinEpsilon) {
+    GraphStore store;
+    auto g = randomGraph(store, 1200);
+    BetweennessOptions exact;
+    auto want = Betweenness::compute(*g, exact);
+
+    for (double eps : { 0.1, 0.08 }) {
+        BetweennessOptions approx;
+        approx.epsilon = eps;
+        approx.seed = 1234;
+        auto got = Betweenness::compute(*g, approx);
+        CHECK(!got.exact && got.sources < g->nodeCount());
+        double worst = 0;
+        for (size_t v = 0; v < g->nodeCount(); ++v) worst = std::max(worst, std::fabs(got.score[v] - want.score[v]));
+        CHECK(worst <= eps);
+
+        // Same seed, same sample, whatever the thread count (up to summation order).
+        approx.threads = 1;
+        auto serial = Betweenness::compute(*g, approx);
+        for (size_t v = 0; v < g->nodeCount(); ++v) CHECK(std::fabs(serial.score[v] - got.score[v]) < kTol);
+    }
+
+    // An epsilon too tight to beat the exact run falls back to it.
+    BetweennessOptions tight;
+    tight.epsilon = 0.001;
+    CHECK(Betweenness::compute(*g, tight).exact);
+}
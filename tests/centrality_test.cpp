@@ -0,0 +1,52 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/Centrality.h"
+#include <random>
+#include <vector>
+#include <string>
+#include <cmath>
+
+using namespace graph;
+
+namespace {
+
+// Enough vertices for several blocks, so the pool actually splits the work.
+std::shared_ptr<const CsrSnapshot> randomGraph(GraphStore& store) {
+    std::vector<std::string> labels(5000, "n");
+    store.addNodes(labels);
+    std::mt19937 rng(7);
+    std::vector<EdgeRecord> edges;
+    for (int i = 0; i < 30000; ++i) edges.push_back({ rng() % 4000, rng() % 4000, 1000 + i });
+    store.addEdges(edges);
+    return store.freeze();
+}
+
+}
+
+// Blocks are summed in a fixed order, so the thread count cannot change a score.
+TEST(scoresIndependentOfThreadCount) {
+    GraphStore store;
+    auto g = randomGraph(store);
+    CentralityOptions one, many;
+    one.threads = 1;
+    many.threads = 6;
+    auto a = Centrality::pageRank(*g, one), b = Centrality::pageRank(*g, many);
+    CHECK(a.converged && b.converged);
+    CHECK(a.iterations == b.iterations);
+    CHECK(a.score == b.score);
+    auto ea = Centrality::eigenvector(*g, one), eb = Centrality::eigenvector(*g, many);
+    CHECK(ea.score == eb.score);
+    auto pa = Centrality::personalizedPageRank(*g, { 3 }, one), pb = Centrality::personalizedPageRank(*g, { 3 }, many);
+    CHECK(pa.score == pb.score);
+}
+
+TEST(pageRankIsADistribution) {
+    GraphStore store;
+    auto g = randomGraph(store);    // ids 4000.. are isolated: dangling mass
+    auto r = Centrality::pageRank(*g);
+    double sum = 0;
+    for (double s : r.score) sum += s;
+    CHECK(std::fabs(sum - 1.0) < 1e-6);
+    auto top = Centrality::personalizedPageRank(*g, { 3 }).top(1);
+    CHECK(!top.empty() && g->idOf(top[0].first) == 3);
+}
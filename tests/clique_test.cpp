@@ -0,0 +1,92 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/CliqueScanner.h"
+#include <random>
+#include <climits>
+#include <vector>
+#include <string>
+
+using namespace graph;
+
+namespace {
+
+struct Fixture {
+    static constexpr uint64_t n = 24;
+    GraphStore store;
+    std::vector<std::vector<bool>> adj = std::vector<std::vector<bool>>(n, std::vector<bool>(n, false));
+
+    // Dense enough for 5-cliques; repeats and self-loops must not count.
+    explicit Fixture(unsigned seed) {
+        std::vector<std::string> labels(n, "n");
+        store.addNodes(labels);
+        std::mt19937 rng(seed);
+        long long ts = 0;
+        for (uint64_t u = 0; u < n; ++u)
+            for (uint64_t v = u + 1; v < n; ++v)
+                if (rng() % 100 < 45) {
+                    adj[u][v] = adj[v][u] = true;
+                    if (rng() % 2) store.addEdge(u, v, ++ts);
+                    else store.addEdge(v, u, ++ts);
+                    if (rng() % 4 == 0) store.addEdge(v, u, ++ts);
+                }
+        for (uint64_t u = 0; u < n; u += 5) store.addEdge(u, u, ++ts);
+    }
+
+    // Every k-subset in lexicographic order, tested pair by pair.
+    void brute(unsigned k, std::vector<CliqueScanner::Clique>& out, CliqueScanner::Clique& cur, uint64_t from) const {
+        if (cur.size() == k) { out.push_back(cur); return; }
+        for (uint64_t v = from; v < n; ++v) {
+            bool ok = true;
+            for (uint64_t u : cur) ok = ok && adj[u][v];
+            if (!ok) continue;
+            cur.push_back(v);
+            brute(k, out, cur, v + 1);
+            cur.pop_back();
+        }
+    }
+};
+
+}
+
+TEST(cliqueCountsMatchBruteForce) {
+    for (unsigned seed : { 1u, 2u, 3u }) {
+        Fixture f(seed);
+        auto g = f.store.freeze();
+        CliqueScanner scanner(*g);
+        for (unsigned k = 3; k <= 5; ++k) {
+            std::vector<CliqueScanner::Clique> expected;
+            CliqueScanner::Clique cur;
+            f.brute(k, expected, cur, 0);
+            CHECK(scanner.countCliques(k) == expected.size());
+            CHECK(scanner.countCliques(k, 4) == expected.size());
+            CHECK(scanner.listCliques(k) == expected);
+            CHECK(scanner.listCliques(k, 4) == expected);
+        }
+        std::vector<CliqueScanner::Clique> triangles;
+        CliqueScanner::Clique cur;
+        f.brute(3, triangles, cur, 0);
+        CHECK(scanner.countTriangles() == triangles.size());
+    }
+}
+
+TEST(noCliquesInATree) {
+    GraphStore store;
+    std::vector<std::string> labels(10, "n");
+    store.addNodes(labels);
+    for (uint64_t v = 1; v < 10; ++v) store.addEdge((v - 1) / 2, v, v);
+    auto g = store.freeze();
+    CliqueScanner scanner(*g);
+    CHECK(scanner.countTriangles() == 0);
+    CHECK(scanner.listCliques(3, 3).empty());
+    CHECK(scanner.countCliques(2) == 9);
+}
+
+TEST(oversizedCliqueIsEmpty) {
+    Fixture f(1);
+    auto g = f.store.freeze();
+    CliqueScanner scanner(*g);
+    CHECK(scanner.countCliques(UINT_MAX) == 0);
+    CHECK(scanner.countCliques(4000000000u, 4) == 0);
+    CHECK(scanner.listCliques(UINT_MAX).empty());
+    CHECK(scanner.listCliques(UINT_MAX, 4).empty());
+}
@@ -0,0 +1,100 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/CommonNeighbors.h"
+#include <random>
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace graph;
+
+namespace {
+
+// Neighborhoods, pair histories and degrees recounted from the raw timeline.
+struct Recount {
+    std::map<uint64_t, std::set<uint64_t>> nbrs;
+    std::map<std::pair<uint64_t, uint64_t>, std::vector<long long>> times;
+    std::map<uint64_t, uint32_t> degree;
+
+    explicit Recount(const GraphStore& store) {
+        store.forEachEdge([&](const Edge& e) {
+            uint64_t s = e.source(), t = e.target();
+            nbrs[s].insert(t);
+            nbrs[t].insert(s);
+            times[{ std::min(s, t), std::max(s, t) }].push_back(e.timestamp());
+            ++degree[s];
+            if (t != s) ++degree[t];
+        });
+    }
+
+    std::vector<uint64_t> shared(uint64_t a, uint64_t b) {
+        std::vector<uint64_t> out;
+        std::set_intersection(nbrs[a].begin(), nbrs[a].end(), nbrs[b].begin(), nbrs[b].end(), std::back_inserter(out));
+        return out;
+    }
+
+    std::vector<long long> history(uint64_t u, uint64_t v) { return times[{ std::min(u, v), std::max(u, v) }]; }
+};
+
+}
+
+// Every pair of a random graph, self-loops and repeated contacts included.
+TEST(matchesRecount) {
+    GraphStore store;
+    std::vector<std::string> labels(60, "n");
+    store.addNodes(labels);
+    std::mt19937 rng(11);
+    for (int i = 0; i < 400; ++i) store.addEdge(rng() % 50, rng() % 50, 1000 + (long long)(rng() % 500));
+    store.isolateNode(7);
+    Recount r(store);
+
+    bool shared = true, overlap = true, witnesses = true;
+    for (uint64_t a = 0; a < 60; ++a)
+        for (uint64_t b = a + 1; b < 60; ++b) {
+            auto want = r.shared(a, b);
+            shared = shared && CommonNeighbors::shared(store, a, b) == want;
+
+            auto o = CommonNeighbors::overlap(store, a, b);
+            overlap = overlap && o.shared == want.size() && o.combined == r.nbrs[a].size() + r.nbrs[b].size() - want.size();
+
+            auto ws = CommonNeighbors::witnesses(store, a, b);
+            witnesses = witnesses && ws.size() == want.size();
+            for (size_t i = 0; witnesses && i < ws.size(); ++i)
+                witnesses = ws[i].id == want[i] && ws[i].degree == r.degree[want[i]]
+                         && ws[i].timesA == r.history(a, want[i]) && ws[i].timesB == r.history(b, want[i]);
+        }
+    CHECK(shared);
+    CHECK(overlap);
+    CHECK(witnesses);
+}
+
+// A hub against a low-degree node takes the galloping path; the lists must
+// follow batches, isolation and repeated contacts.
+TEST(hubListsFollowMutations) {
+    GraphStore store;
+    std::vector<std::string> labels(600, "n");
+    store.addNodes(labels);
+    std::vector<EdgeRecord> batch;
+    for (uint64_t v = 2; v < 600; ++v) batch.push_back({ 0, v, (long long)(600 - v) });
+    store.addEdges(batch);
+    for (uint64_t v : { 3, 50, 51, 400, 599 }) store.addEdge(1, v, 1000);
+    store.addEdges(std::vector<EdgeRecord>{ { 1, 50, 2000 }, { 1, 1, 2001 }, { 0, 1, 2002 } });
+    store.isolateNode(51);
+
+    Recount r(store);
+    CHECK(CommonNeighbors::shared(store, 0, 1) == r.shared(0, 1));
+    CHECK((r.shared(0, 1) == std::vector<uint64_t>{ 1, 3, 50, 400, 599 }));
+    auto o = CommonNeighbors::overlap(store, 1, 0);
+    CHECK(o.shared == 5 && o.combined == r.nbrs[0].size() + r.nbrs[1].size() - 5);
+    for (uint64_t v : { 0, 1, 51, 400 }) CHECK((store.getNeighbors(v) == std::vector<uint64_t>(r.nbrs[v].begin(), r.nbrs[v].end())));
+}
+
+TEST(unknownNodesShareNothing) {
+    GraphStore store;
+    store.addNode("a");
+    CHECK(CommonNeighbors::shared(store, 0, 99).empty());
+    CHECK(CommonNeighbors::overlap(store, 98, 99).combined == 0);
+    CHECK(CommonNeighbors::witnesses(store, 0, 99).empty());
+}
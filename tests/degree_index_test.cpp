@@ -0,0 +1,138 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include <random>
+#include <set>
+#include <map>
+#include <vector>
+#include <string>
+#include <climits>
+#include <algorithm>
+
+using namespace graph;
+
+namespace {
+
+using Metric = DegreeIndex::Metric;
+using Top = std::vector<std::pair<uint64_t, uint32_t>>;
+constexpr Metric kMetrics[] = { Metric::Total, Metric::Distinct, Metric::Windowed };
+constexpr long long kWindow = 10;
+
+// Mirrors the store's mutations closely enough to recount every degree from
+// scratch: the live edges come from forEachEdge, only the window's anchor (the
+// newest timestamp since the last clear) has to be remembered here.
+struct Fixture {
+    GraphStore store;
+    std::mt19937 rng;
+    std::vector<uint64_t> nodes;
+    long long newest = LLONG_MIN;
+
+    explicit Fixture(unsigned seed) : rng(seed) {
+        store.setDegreeWindow(kWindow);
+        addNodes(20);
+    }
+
+    void addNodes(size_t n) {
+        for (size_t i = 0; i < n; ++i) nodes.push_back(store.addNode("n"));
+    }
+
+    EdgeRecord randomEdge() {
+        std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+        std::uniform_int_distribution<long long> ts(0, 60);
+        EdgeRecord r{ nodes[pick(rng)], nodes[pick(rng)], ts(rng) };
+        newest = std::max(newest, r.timestamp);
+        return r;
+    }
+
+    void addEdge() {
+        auto r = randomEdge();
+        store.addEdge(r.source, r.target, r.timestamp);
+    }
+
+    void addEdges(size_t n) {
+        std::vector<EdgeRecord> batch;
+        for (size_t i = 0; i < n; ++i) batch.push_back(randomEdge());
+        store.addEdges(batch);
+    }
+
+    void isolate() {
+        std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+        store.isolateNode(nodes[pick(rng)]);
+    }
+
+    void clear() {
+        store.clear();
+        nodes.clear();
+        newest = LLONG_MIN;
+        addNodes(15);
+    }
+
+    uint32_t recount(Metric m, uint64_t id) const {
+        uint32_t c = 0;
+        std::set<uint64_t> others;
+        store.forEachEdge([&](const Edge& e) {
+            if (e.source() != id && e.target() != id) return;
+            if (m == Metric::Windowed && e.timestamp() < newest - kWindow) return;
+            ++c;
+            others.insert(e.source() == id ? e.target() : e.source());
+        });
+        return m == Metric::Distinct ? static_cast<uint32_t>(others.size()) : c;
+    }
+
+    // Highest count first, ties to the higher ID, as DegreeIndex::top orders them.
+    Top expected(Metric m, size_t k) const {
+        std::vector<std::pair<uint32_t, uint64_t>> all;
+        for (uint64_t id : nodes) all.push_back({ recount(m, id), id });
+        std::sort(all.rbegin(), all.rend());
+        Top out;
+        for (size_t i = 0; i < all.size() && i < k; ++i) out.push_back({ all[i].second, all[i].first });
+        return out;
+    }
+
+    bool matches() const {
+        for (Metric m : kMetrics) {
+            for (size_t k : { size_t(1), size_t(5), SIZE_MAX })
+                if (store.topByDegree(m, k) != expected(m, k)) return false;
+            for (uint64_t id : nodes) {
+                auto c = store.getDegreeCounts(id);
+                uint32_t got = m == Metric::Total ? c.total : m == Metric::Distinct ? c.distinct : c.windowed;
+                if (got != recount(m, id)) return false;
+            }
+        }
+        return true;
+    }
+};
+
+}
+
+TEST(countersMatchRecount) {
+    for (unsigned seed : { 1u, 2u, 3u }) {
+        Fixture f(seed);
+        CHECK(f.matches());
+        for (int round = 0; round < 6; ++round) {
+            for (int i = 0; i < 15; ++i) f.addEdge();
+            CHECK(f.matches());
+            f.addEdges(25);
+            CHECK(f.matches());
+            f.isolate();
+            f.isolate();
+            CHECK(f.matches());
+            if (round == 3) {
+                f.clear();
+                CHECK(f.matches());
+            }
+        }
+    }
+}
+
+TEST(windowChangeRecounts) {
+    Fixture f(7);
+    f.addEdges(60);
+    f.store.setDegreeWindow(kWindow * 3);
+    auto wide = f.store.topByDegree(Metric::Windowed, SIZE_MAX);
+    f.store.setDegreeWindow(kWindow);
+    CHECK(f.matches());
+    uint64_t wideSum = 0, narrowSum = 0;
+    for (auto const& [id, c] : wide) wideSum += c;
+    for (auto const& [id, c] : f.store.topByDegree(Metric::Windowed, SIZE_MAX)) narrowSum += c;
+    CHECK(wideSum >= narrowSum);
+}
@@ -0,0 +1,116 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "concurrency/IngestQueue.h"
+#include "concurrency/IngestFeed.h"
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <atomic>
+#include <climits>
+
+using namespace graph;
+
+namespace {
+
+using Triple = std::tuple<uint64_t, uint64_t, long long>;
+
+std::map<Triple, int> edgeCounts(GraphStore& store) {
+    std::map<Triple, int> counts;
+    store.forEachEdgeInRange(LLONG_MIN, LLONG_MAX, [&](const Edge& e) {
+        ++counts[{ e.source(), e.target(), e.timestamp() }];
+    });
+    return counts;
+}
+
+}
+
+// Producers racing on a small ring: every record arrives exactly once.
+TEST(concurrentProducersLoseNothing) {
+    GraphStore store;
+    IngestQueue::Options opt;
+    opt.capacity = 256;     // small enough that producers have to wait for room
+    opt.maxBatch = 64;
+    IngestQueue queue(store, opt);
+
+    const int producers = 8, perProducer = 20000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer; ++i) queue.push(p, i % 97, (long long)p * perProducer + i);
+        });
+    for (auto& t : threads) t.join();
+    queue.flush();
+
+    auto s = queue.stats();
+    CHECK(s.enqueued == uint64_t(producers) * perProducer);
+    CHECK(s.applied == s.enqueued);
+    CHECK(store.edgeCount() == size_t(producers) * perProducer);
+    auto counts = edgeCounts(store);
+    CHECK(counts.size() == size_t(producers) * perProducer);
+    bool each = true;
+    for (int p = 0; p < producers; ++p)
+        for (int i = 0; i < perProducer; ++i)
+            each = each && counts.count({ uint64_t(p), uint64_t(i % 97), (long long)p * perProducer + i }) == 1;
+    CHECK(each);
+}
+
+// stop() while producers are still pushing: whatever push accepted is applied.
+TEST(stopAppliesEverythingAccepted) {
+    GraphStore store;
+    IngestQueue queue(store);
+    std::atomic<uint64_t> accepted{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 4; ++p)
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < 50000; ++i) {
+                if (!queue.push(p, p + 1, i)) break;
+                accepted.fetch_add(1);
+            }
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.stop();
+    for (auto& t : threads) t.join();
+    CHECK(queue.stats().applied == accepted.load());
+    CHECK(store.edgeCount() == accepted.load());
+    CHECK(!queue.tryPush(0, 1, 2));
+}
+
+// Several file feeds on one queue, as the ingest command runs them.
+TEST(feedsReadFilesConcurrently) {
+    std::string dir = check::tempDir();
+    const int files = 4, lines = 5000;
+    for (int f = 0; f < files; ++f) {
+        std::ofstream out(dir + "/feed" + std::to_string(f) + ".txt");
+        for (int i = 0; i < lines; ++i) out << f << (i % 2 ? "," : " ") << i << " " << (f * lines + i) << "\n";
+        out << "not an edge\n";
+    }
+    GraphStore store;
+    IngestQueue queue(store);
+    std::vector<std::unique_ptr<IngestFeed>> feeds;
+    for (int f = 0; f < files; ++f) {
+        std::string error;
+        feeds.push_back(IngestFeed::open(queue, dir + "/feed" + std::to_string(f) + ".txt", error));
+        CHECK(feeds.back() != nullptr);
+    }
+    for (auto& feed : feeds) {
+        while (feed->stats().running) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK(feed->stats().pushed == uint64_t(lines));
+        CHECK(feed->stats().malformed == 1);
+    }
+    queue.flush();
+    CHECK(store.edgeCount() == size_t(files) * lines);
+    CHECK(edgeCounts(store).size() == size_t(files) * lines);
+    check::removeDir(dir);
+}
+
+TEST(parseLineFormats) {
+    uint64_t s, t; long long ts = 0; bool hasTs;
+    CHECK(IngestFeed::parseLine("1 2 3", s, t, ts, hasTs) && s == 1 && t == 2 && ts == 3 && hasTs);
+    CHECK(IngestFeed::parseLine("4,5\r", s, t, ts, hasTs) && s == 4 && t == 5 && !hasTs);
+    CHECK(IngestFeed::parseLine("\t6\t7\t-8", s, t, ts, hasTs) && ts == -8);
+    CHECK(!IngestFeed::parseLine("1", s, t, ts, hasTs));
+    CHECK(!IngestFeed::parseLine("1 2 3 4", s, t, ts, hasTs));
+    CHECK(!IngestFeed::parseLine("a b", s, t, ts, hasTs));
+}
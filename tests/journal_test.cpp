@@ -0,0 +1,185 @@
+#include "tests/Check.h"
+#include "tests/GraphDump.h"
+#include "persistence/Journal.h"
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace graph;
+
+namespace {
+
+std::map<uint64_t, std::string> labelsById(const GraphStore& store) {
+    std::map<uint64_t, std::string> m;
+    store.forEachNode([&](const Node& n) { m[n.id()] = n.label(); });
+    return m;
+}
+
+// Before and after a recovery: same contents, same IDs, and a version that
+// does not go back (replay may bump it further).
+bool same(const GraphStore& a, const GraphStore& b) {
+    return GraphDump::of(a) == GraphDump::of(b) && labelsById(a) == labelsById(b) && b.version() >= a.version();
+}
+
+std::unique_ptr<Journal> openJournal(GraphStore& store, const std::string& dir) {
+    std::string error;
+    auto j = Journal::open(store, dir, Journal::Options{}, error);
+    if (!j) std::fprintf(stderr, "  %s\n", error.c_str());
+    return j;
+}
+
+// Exercises every record type.
+void mutate(GraphStore& store, Journal& j) {
+    uint64_t a = store.addNode("a");
+    std::vector<std::string> labels = { "b", "c", "d" }, images = { "", "c.png", "" };
+    store.addNodes(labels, images);
+    store.addEdge(a, a + 1, 10);
+    std::vector<EdgeRecord> batch = { { a + 1, a + 2, 20 }, { a + 2, a + 3, 15 }, { a + 3, a, 30 } };
+    store.addEdges(batch);
+    store.renameNode(a + 3, "d2");
+    store.setNodeImage(a, "a.png");
+    store.isolateNode(a + 1);
+    j.commit();
+}
+
+uint64_t logSize(const std::string& dir, uint64_t gen) {
+    return std::filesystem::file_size(Journal::logPath(dir, gen));
+}
+
+}
+
+TEST(recoverReplaysEveryRecord) {
+    std::string dir = check::tempDir();
+    GraphStore store;
+    store.addNodes(std::vector<std::string>{ "seed1", "seed2" });
+    store.addEdge(0, 1, 5);
+    {
+        auto j = openJournal(store, dir);
+        CHECK(j != nullptr);
+        mutate(store, *j);
+    }
+    GraphStore back;
+    auto rec = Journal::recover(back, dir);
+    CHECK(rec.ok);
+    CHECK(rec.generation == 1);
+    CHECK(rec.replayed > 0);
+    CHECK(rec.discardedBytes == 0);
+    CHECK(same(store, back));
+    check::removeDir(dir);
+}
+
+TEST(recoverAfterCheckpoint) {
+    std::string dir = check::tempDir();
+    GraphStore store;
+    {
+        auto j = openJournal(store, dir);
+        mutate(store, *j);
+        std::string error;
+        CHECK(j->checkpoint(error));
+        store.addEdge(0, 2, 99);
+        store.clear();
+        store.addNode("after clear");
+        j->commit();
+    }
+    GraphStore back;
+    auto rec = Journal::recover(back, dir);
+    CHECK(rec.ok);
+    CHECK(rec.generation == 2);
+    CHECK(!std::filesystem::exists(Journal::checkpointPath(dir, 1)));
+    CHECK(same(store, back));
+    check::removeDir(dir);
+}
+
+// A crash mid-write leaves part of the last record; recovery keeps
+// everything before it.
+TEST(tornTailIsDropped) {
+    std::string dir = check::tempDir();
+    GraphStore store, before;
+    uint64_t intact;
+    {
+        auto j = openJournal(store, dir);
+        mutate(store, *j);
+        intact = logSize(dir, 1);
+        store.addEdge(0, 3, 500);
+        j->commit();
+    }
+    CHECK(Journal::recover(before, dir).ok);
+    CHECK(same(store, before));
+    std::filesystem::resize_file(Journal::logPath(dir, 1), logSize(dir, 1) - 3);
+
+    GraphStore back;
+    auto rec = Journal::recover(back, dir);
+    CHECK(rec.ok);
+    CHECK(rec.discardedBytes == logSize(dir, 1) - intact);
+    CHECK(back.edgeCount() == store.edgeCount() - 1);
+    CHECK(back.getNodeLabel(3) == store.getNodeLabel(3));
+    check::removeDir(dir);
+}
+
+// A record whose checksum fails ends replay there.
+TEST(corruptRecordEndsReplay) {
+    std::string dir = check::tempDir();
+    GraphStore store;
+    uint64_t intact;
+    {
+        auto j = openJournal(store, dir);
+        mutate(store, *j);
+        intact = logSize(dir, 1);
+        store.addEdge(0, 3, 500);
+        j->commit();
+        store.addEdge(1, 3, 600);
+        j->commit();
+    }
+    {
+        std::fstream f(Journal::logPath(dir, 1), std::ios::in | std::ios::out | std::ios::binary);
+        f.seekg(intact + WriteAheadLog::kFrameBytes + 4);
+        char c = 0;
+        f.get(c);
+        f.seekp(intact + WriteAheadLog::kFrameBytes + 4);
+        f.put(static_cast<char>(c ^ 0x40));
+    }
+    GraphStore back;
+    auto rec = Journal::recover(back, dir);
+    CHECK(rec.ok);
+    CHECK(rec.discardedBytes == logSize(dir, 1) - intact);
+    CHECK(back.edgeCount() == store.edgeCount() - 2);
+    check::removeDir(dir);
+}
+
+TEST(openRefusesHistoryResumeContinues) {
+    std::string dir = check::tempDir();
+    {
+        GraphStore store;
+        auto j = openJournal(store, dir);
+        mutate(store, *j);
+    }
+    GraphStore other;
+    std::string error;
+    CHECK(Journal::open(other, dir, Journal::Options{}, error) == nullptr);
+    CHECK(!error.empty());
+    CHECK(std::filesystem::exists(Journal::logPath(dir, 1)));
+
+    GraphStore store;
+    auto rec = Journal::recover(store, dir);
+    CHECK(rec.ok);
+    {
+        GraphStore changed;
+        CHECK(Journal::recover(changed, dir).ok);
+        changed.addNode("late");
+        CHECK(Journal::resume(changed, rec, Journal::Options{}, error) == nullptr);
+    }
+    {
+        auto j = Journal::resume(store, rec, Journal::Options{}, error);
+        CHECK(j != nullptr);
+        if (!j) { check::removeDir(dir); return; }
+        store.addNode("resumed");
+        store.addEdge(0, 4, 700);
+        j->commit();
+    }
+    GraphStore back;
+    CHECK(Journal::recover(back, dir).ok);
+    CHECK(same(store, back));
+    check::removeDir(dir);
+}
@@ -0,0 +1,60 @@
+#include "tests/Check.h"
+#include "persistence/JsonWriter.h"
+#include <atomic>
+#include <thread>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace graph;
+
+namespace {
+
+// Pulls every integer following `key` out of a document.
+std::vector<uint64_t> numbersAfter(const std::string& doc, const std::string& key) {
+    std::vector<uint64_t> out;
+    for (size_t at = doc.find(key); at != std::string::npos; at = doc.find(key, at + 1))
+        out.push_back(std::stoull(doc.substr(at + key.size())));
+    return out;
+}
+
+}
+
+TEST(documentShapeAndEscaping) {
+    GraphStore store;
+    store.addNode("a \"q\"\n");
+    store.addNode("b");
+    store.setNodeImage(1, "b.png");
+    store.addEdge(0, 1, 30);
+    store.addEdge(1, 0, 10);    // out of order: the view sorts
+    store.addEdge(0, 0, 20);
+    std::string doc = GraphJson::toString(store, 15, 30);
+    CHECK(doc.find("\"label\":\"a \\\"q\\\"\\n\"") != std::string::npos);
+    CHECK(doc.find("\"image\":\"b.png\"") != std::string::npos);
+    CHECK(doc.substr(doc.find("\"edges\"")) == "\"edges\":[{\"from\":0,\"to\":0,\"ts\":20},{\"from\":0,\"to\":1,\"ts\":30}]}");
+    CHECK(GraphJson::toString(store, 40, 50).find("\"edges\":[]}") != std::string::npos);
+}
+
+// A writer adding a node and then an edge to it, racing the export: every
+// exported edge must point at an exported node.
+TEST(exportIsOneConsistentVersion) {
+    GraphStore store;
+    store.addNode("root");
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; i < 20000 && !done.load(); ++i) {
+            uint64_t id = store.addNode("n" + std::to_string(i));
+            store.addEdge(0, id, i);
+        }
+    });
+    bool consistent = true;
+    for (int round = 0; round < 50; ++round) {
+        std::string doc = GraphJson::toString(store);
+        auto ids = numbersAfter(doc, "{\"id\":");
+        std::set<uint64_t> nodes(ids.begin(), ids.end());
+        for (uint64_t t : numbersAfter(doc, "\"to\":")) consistent = consistent && nodes.count(t);
+    }
+    done.store(true);
+    writer.join();
+    CHECK(consistent);
+}
@@ -0,0 +1,143 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/LinkPrediction.h"
+#include <random>
+#include <set>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+using namespace graph;
+
+namespace {
+
+using Metric = LinkPredictionOptions::Metric;
+constexpr Metric kMetrics[] = { Metric::Jaccard, Metric::AdamicAdar, Metric::ResourceAllocation };
+
+double score(const SimilarPair& p, Metric m) {
+    return m == Metric::Jaccard ? p.jaccard : m == Metric::ResourceAllocation ? p.resourceAllocation : p.adamicAdar;
+}
+
+// Best first, ties by (a, b): the order LinkPrediction promises.
+void rank(std::vector<SimilarPair>& v, Metric m) {
+    std::sort(v.begin(), v.end(), [m](const SimilarPair& x, const SimilarPair& y) {
+        double sx = score(x, m), sy = score(y, m);
+        if (sx != sy) return sx > sy;
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+}
+
+bool same(const std::vector<SimilarPair>& x, const std::vector<SimilarPair>& y) {
+    if (x.size() != y.size()) return false;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (x[i].a != y[i].a || x[i].b != y[i].b || x[i].common != y[i].common) return false;
+        if (std::fabs(x[i].jaccard - y[i].jaccard) > 1e-12 || std::fabs(x[i].adamicAdar - y[i].adamicAdar) > 1e-12
+            || std::fabs(x[i].resourceAllocation - y[i].resourceAllocation) > 1e-12) return false;
+    }
+    return true;
+}
+
+bool identical(const std::vector<std::vector<SimilarPair>>& x, const std::vector<std::vector<SimilarPair>>& y) {
+    if (x.size() != y.size()) return false;
+    for (size_t v = 0; v < x.size(); ++v) {
+        if (x[v].size() != y[v].size()) return false;
+        for (size_t i = 0; i < x[v].size(); ++i)
+            if (x[v][i].a != y[v][i].a || x[v][i].b != y[v][i].b || x[v][i].common != y[v][i].common
+                || x[v][i].jaccard != y[v][i].jaccard || x[v][i].adamicAdar != y[v][i].adamicAdar
+                || x[v][i].resourceAllocation != y[v][i].resourceAllocation) return false;
+    }
+    return true;
+}
+
+// Self-loops and repeated contacts included; neither may count as a neighbor twice.
+struct Fixture {
+    static constexpr uint64_t n = 40;
+    GraphStore store;
+    std::vector<std::set<uint64_t>> nbrs = std::vector<std::set<uint64_t>>(n);
+
+    explicit Fixture(unsigned seed) {
+        std::vector<std::string> labels(n, "n");
+        store.addNodes(labels);
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 150; ++i) {
+            uint64_t u = rng() % n, v = rng() % n;
+            store.addEdge(u, v, i);
+            if (u != v) { nbrs[u].insert(v); nbrs[v].insert(u); }
+        }
+    }
+
+    // Every pair with a shared neighbor, scored the slow way: both orientations
+    // when `bothWays`, else only a < b.
+    std::vector<SimilarPair> brute(bool skipAdjacent, bool bothWays) const {
+        std::vector<SimilarPair> out;
+        for (uint64_t a = 0; a < n; ++a)
+            for (uint64_t b = 0; b < n; ++b) {
+                if (a == b || (!bothWays && b < a)) continue;
+                if (skipAdjacent && nbrs[a].count(b)) continue;
+                SimilarPair p{ a, b, 0, 0.0, 0.0, 0.0 };
+                for (uint64_t w : nbrs[a]) {
+                    if (!nbrs[b].count(w)) continue;
+                    ++p.common;
+                    p.adamicAdar += 1.0 / std::log(double(nbrs[w].size()));
+                    p.resourceAllocation += 1.0 / double(nbrs[w].size());
+                }
+                if (p.common == 0) continue;
+                p.jaccard = double(p.common) / double(nbrs[a].size() + nbrs[b].size() - p.common);
+                out.push_back(p);
+            }
+        return out;
+    }
+};
+
+}
+
+TEST(perNodeListsMatchBruteForce) {
+    for (unsigned seed : { 1u, 2u }) {
+        Fixture f(seed);
+        auto g = f.store.freeze();
+        for (bool skip : { true, false })
+            for (Metric m : kMetrics) {
+                LinkPredictionOptions opt;
+                opt.rankBy = m;
+                opt.skipAdjacent = skip;
+                opt.topPerNode = 4;
+                auto lists = LinkPrediction::topPerNode(*g, opt);
+                auto all = f.brute(skip, true);
+                bool ok = lists.size() == Fixture::n;
+                for (uint64_t a = 0; ok && a < Fixture::n; ++a) {
+                    std::vector<SimilarPair> want;
+                    for (auto const& p : all) if (p.a == a) want.push_back(p);
+                    rank(want, m);
+                    if (want.size() > opt.topPerNode) want.resize(opt.topPerNode);
+                    ok = same(lists[g->indexOf(a)], want);
+                }
+                CHECK(ok);
+            }
+    }
+}
+
+TEST(globalTopMatchesFullSort) {
+    Fixture f(3);
+    auto g = f.store.freeze();
+    for (Metric m : kMetrics)
+        for (size_t k : { size_t(1), size_t(7), size_t(10000) }) {
+            LinkPredictionOptions opt;
+            opt.rankBy = m;
+            auto want = f.brute(true, false);
+            rank(want, m);
+            if (want.size() > k) want.resize(k);
+            CHECK(same(LinkPrediction::topPairs(*g, k, opt), want));
+        }
+}
+
+TEST(outputIndependentOfThreadCount) {
+    Fixture f(4);
+    auto g = f.store.freeze();
+    LinkPredictionOptions one, many;
+    one.threads = 1;
+    many.threads = 6;
+    CHECK(identical(LinkPrediction::topPerNode(*g, one), LinkPrediction::topPerNode(*g, many)));
+    auto a = LinkPrediction::topPairs(*g, 20, one), b = LinkPrediction::topPairs(*g, 20, many);
+    CHECK(identical({ a }, { b }));
+}
@@ -0,0 +1,181 @@
+#include "tests/Check.h"
+#include "tests/GraphDump.h"
+#include "persistence/BinarySnapshot.h"
+#include "persistence/TextSnapshot.h"
+#include <fstream>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace graph;
+
+namespace {
+
+// Labels with spaces and quotes, custom images, an isolated node and edges
+// inserted out of time order.
+void fill(GraphStore& store) {
+    std::vector<std::string> labels = { "alice", "bob smith", "carol \"c\"", "dave", "lonely" };
+    uint64_t first = store.addNodes(labels);
+    store.setNodeImage(first + 1, "bob.png");
+    store.setNodeImage(first + 2, "img/carol.jpg");
+    long long ts[] = { 50, 10, 30, 10, 70, 20, 60 };
+    for (int i = 0; i < 7; ++i) store.addEdge(first + i % 4, first + (i + 1) % 4, ts[i]);
+    store.addEdge(first, first, 5);
+}
+
+// Counts what a load reports to a journal.
+struct Recorder : MutationListener {
+    int nodeCalls = 0, edgeCalls = 0, imageCalls = 0, other = 0;
+    std::vector<std::string> images;
+    void nodesAdded(uint64_t, std::span<const std::string>, std::span<const std::string> imgs, uint64_t) override {
+        ++nodeCalls;
+        images.assign(imgs.begin(), imgs.end());
+    }
+    void edgesAdded(std::span<const EdgeRecord>, uint64_t) override { ++edgeCalls; }
+    void nodeRenamed(uint64_t, const std::string&, uint64_t) override { ++other; }
+    void nodeImageSet(uint64_t, const std::string&, uint64_t) override { ++imageCalls; }
+    void nodeIsolated(uint64_t, uint64_t) override { ++other; }
+    void cleared(uint64_t) override { ++other; }
+};
+
+}
+
+// Images travel with the bulk node insert: one record per load, not one per image.
+TEST(textLoadAddsImagesInBulk) {
+    std::string dir = check::tempDir();
+    {
+        std::ofstream out(dir + "/g.txt");
+        out << "NODE 7 \"alice\" \"a.png\"\nNODE 9 \"bob\" \"default.png\"\nNODE 3 \"carol\" \"c.png\"\n"
+            << "EDGE 7 9 100\nEDGE 9 3 50\n";
+    }
+    GraphStore store;
+    Recorder rec;
+    store.setListener(&rec);
+    uint64_t before = store.version();
+    auto res = TextSnapshot::load(store, dir + "/g.txt");
+    store.setListener(nullptr);
+    CHECK(res.ok && res.nodes == 3 && res.edges == 2);
+    CHECK(store.version() == before + 3);     // clear, nodes, edges
+    CHECK(rec.nodeCalls == 1 && rec.edgeCalls == 1 && rec.imageCalls == 0);
+    CHECK((rec.images == std::vector<std::string>{ "a.png", "", "c.png" }));
+    auto d = GraphDump::of(store);
+    CHECK(d.images["alice"] == "a.png" && d.images["bob"] == "default.png" && d.images["carol"] == "c.png");
+    CHECK(d.edges.count({ "alice", "bob", 100 }) == 1 && d.edges.count({ "bob", "carol", 50 }) == 1);
+    check::removeDir(dir);
+}
+
+TEST(binaryRoundTrip) {
+    std::string dir = check::tempDir();
+    GraphStore a;
+    fill(a);
+    CHECK(BinarySnapshot::save(a, dir + "/g.bin"));
+
+    std::string error;
+    auto snap = MappedSnapshot::open(dir + "/g.bin", error);
+    CHECK(snap != nullptr);
+    if (snap) {
+        CHECK(snap->nodeCount() == 5);
+        CHECK(snap->edgeCount() == 8);
+        CHECK(snap->storeVersion() == a.version());
+        const int64_t* ts = snap->timestamps();
+        CHECK(std::is_sorted(ts, ts + snap->edgeCount()));
+
+        GraphStore b;
+        b.addNode("stale");     // load replaces, not merges
+        Recorder rec;
+        b.setListener(&rec);
+        uint64_t before = b.version();
+        BinarySnapshot::load(b, *snap);
+        b.setListener(nullptr);
+        CHECK(GraphDump::of(b) == GraphDump::of(a));
+        CHECK(b.edgeCountInRange(10, 30) == 4);     // time index rebuilt by the bulk insert
+        CHECK(b.version() == before + 3);     // clear, nodes with images, edges
+        CHECK(rec.nodeCalls == 1 && rec.imageCalls == 0 && rec.edgeCalls == 1);
+
+        GraphStore c;
+        c.setListener(&rec);
+        BinarySnapshot::restore(c, *snap);
+        c.setListener(nullptr);
+        CHECK(GraphDump::of(c) == GraphDump::of(a));
+        CHECK(rec.imageCalls == 0);
+        CHECK(c.getNodeLabel(1) == a.getNodeLabel(1));
+    }
+    check::removeDir(dir);
+}
+
+TEST(emptyStoreRoundTrip) {
+    std::string dir = check::tempDir();
+    GraphStore a;
+    CHECK(BinarySnapshot::save(a, dir + "/g.bin"));
+    std::string error;
+    auto snap = MappedSnapshot::open(dir + "/g.bin", error);
+    CHECK(snap != nullptr);
+    GraphStore b;
+    if (snap) BinarySnapshot::load(b, *snap);
+    CHECK(b.nodeCount() == 0 && b.edgeCount() == 0);
+    check::removeDir(dir);
+}
+
+// Edges with no nodes to remap them onto: refused on open.
+TEST(rejectsEdgesWithoutNodes) {
+    std::string dir = check::tempDir();
+    GraphStore a;
+    a.addEdge(5, 6, 1);
+    CHECK(BinarySnapshot::save(a, dir + "/g.bin"));
+    std::string error;
+    CHECK(MappedSnapshot::open(dir + "/g.bin", error) == nullptr);
+    CHECK(error == "snapshot has edges but no nodes");
+    check::removeDir(dir);
+}
+
+// After clear() the store's IDs no longer start at 0; unknown endpoints must
+// still land on a loaded node, as they do in the binary loader.
+TEST(textLoadAfterClearRemapsUnknownEndpoints) {
+    std::string dir = check::tempDir();
+    {
+        std::ofstream out(dir + "/g.txt");
+        out << "NODE 7 \"alice\" \"default.png\"\nNODE 9 \"bob\" \"default.png\"\n"
+            << "EDGE 7 9 100\nEDGE 9 42 50\n";
+    }
+    GraphStore store;
+    store.addNodes(std::vector<std::string>{ "x", "y", "z" });
+    store.clear();
+    auto res = TextSnapshot::load(store, dir + "/g.txt");
+    CHECK(res.ok && res.nodes == 2 && res.edges == 2);
+    bool dangling = false;
+    store.forEachEdge([&](const Edge& e) { dangling = dangling || !store.hasNode(e.source()) || !store.hasNode(e.target()); });
+    CHECK(!dangling);
+    auto d = GraphDump::of(store);
+    CHECK(d.edges.count({ "bob", "alice", 50 }) == 1);
+
+    // With no node to remap onto, the file is refused and the store kept.
+    std::ofstream(dir + "/edges.txt") << "EDGE 1 2 3\n";
+    res = TextSnapshot::load(store, dir + "/edges.txt");
+    CHECK(!res.ok && res.error == "snapshot has edges but no nodes");
+    CHECK(GraphDump::of(store) == d);
+    check::removeDir(dir);
+}
+
+TEST(rejectsTruncatedAndForeignFiles) {
+    std::string dir = check::tempDir();
+    GraphStore a;
+    fill(a);
+    CHECK(BinarySnapshot::save(a, dir + "/g.bin"));
+    std::string error;
+    std::filesystem::resize_file(dir + "/g.bin", std::filesystem::file_size(dir + "/g.bin") - 8);
+    CHECK(MappedSnapshot::open(dir + "/g.bin", error) == nullptr);
+    std::ofstream(dir + "/text.bin") << "NODE 0 \"a\" \"default.png\"\n";
+    CHECK(MappedSnapshot::open(dir + "/text.bin", error) == nullptr);
+
+    // Only the one header layout is understood.
+    CHECK(BinarySnapshot::save(a, dir + "/v.bin"));
+    {
+        std::fstream f(dir + "/v.bin", std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t other = MappedSnapshot::kVersion + 1;
+        f.seekp(offsetof(BinarySnapshotHeader, version));
+        f.write(reinterpret_cast<const char*>(&other), sizeof(other));
+    }
+    CHECK(MappedSnapshot::open(dir + "/v.bin", error) == nullptr);
+    CHECK(error.find("version") != std::string::npos);
+    check::removeDir(dir);
+}
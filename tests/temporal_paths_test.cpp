@@ -0,0 +1,118 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/TemporalPaths.h"
+#include <set>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace graph;
+
+namespace {
+
+using Mode = TemporalPaths::Mode;
+constexpr Mode kModes[] = { Mode::EarliestArrival, Mode::LatestDeparture, Mode::Fastest, Mode::FewestHops };
+
+// A=0 reaches D=3 four ways:
+//   via B  departs 1, arrives 10
+//   via C  departs 2, arrives 5    (earliest arrival)
+//   via E  departs 8, arrives 9    (fastest and latest departure before 15)
+//   direct at 20                   (fewest hops)
+// F-G-H only runs backwards in time; I-J-K chains on equal timestamps.
+struct Fixture {
+    GraphStore store;
+    std::set<std::tuple<uint64_t, uint64_t, long long>> edges;
+
+    Fixture() {
+        store.addNodes(std::vector<std::string>{ "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K" });
+        add(0, 1, 1); add(1, 3, 10);
+        add(0, 2, 2); add(2, 3, 5);
+        add(0, 4, 8); add(4, 3, 9);
+        add(3, 0, 20);
+        add(5, 6, 5); add(6, 7, 3);
+        add(8, 9, 4); add(9, 10, 4);
+    }
+
+    void add(uint64_t u, uint64_t v, long long ts) {
+        store.addEdge(u, v, ts);
+        edges.insert({ std::min(u, v), std::max(u, v), ts });
+    }
+
+    // Every hop is a real edge, times never go back, and the window holds.
+    bool valid(const Journey& j, uint64_t src, uint64_t dst, long long from, long long until) const {
+        if (!j.found() || j.nodes.front() != src || j.nodes.back() != dst) return false;
+        if (j.nodes.size() != j.times.size() + 1) return false;
+        for (size_t i = 0; i < j.times.size(); ++i) {
+            uint64_t u = j.nodes[i], v = j.nodes[i + 1];
+            if (!edges.count({ std::min(u, v), std::max(u, v), j.times[i] })) return false;
+            if (j.times[i] < from || j.times[i] > until) return false;
+            if (i && j.times[i] < j.times[i - 1]) return false;
+        }
+        return true;
+    }
+};
+
+}
+
+TEST(eachModePicksItsRoute) {
+    Fixture f;
+    auto g = f.store.freeze();
+    TemporalPaths paths(*g);
+
+    Journey early = paths.find(Mode::EarliestArrival, 0, 3);
+    CHECK(f.valid(early, 0, 3, LLONG_MIN, LLONG_MAX));
+    CHECK(early.arrival() == 5);
+    CHECK((early.nodes == std::vector<uint64_t>{ 0, 2, 3 }));
+
+    Journey late = paths.find(Mode::LatestDeparture, 0, 3);
+    CHECK(f.valid(late, 0, 3, LLONG_MIN, LLONG_MAX));
+    CHECK(late.departure() == 20);
+
+    Journey hops = paths.find(Mode::FewestHops, 0, 3);
+    CHECK(f.valid(hops, 0, 3, LLONG_MIN, LLONG_MAX));
+    CHECK(hops.hops() == 1);
+
+    Journey fast = paths.find(Mode::Fastest, 0, 3);
+    CHECK(f.valid(fast, 0, 3, LLONG_MIN, LLONG_MAX));
+    CHECK(fast.arrival() - fast.departure() == 0);
+}
+
+TEST(windowLimitsTheRoutes) {
+    Fixture f;
+    auto g = f.store.freeze();
+    TemporalPaths paths(*g);
+
+    Journey late = paths.find(Mode::LatestDeparture, 0, 3, LLONG_MIN, 15);
+    CHECK(f.valid(late, 0, 3, LLONG_MIN, 15));
+    CHECK(late.departure() == 8);
+
+    Journey fast = paths.find(Mode::Fastest, 0, 3, LLONG_MIN, 15);
+    CHECK(f.valid(fast, 0, 3, LLONG_MIN, 15));
+    CHECK((fast.nodes == std::vector<uint64_t>{ 0, 4, 3 }));
+
+    Journey hops = paths.find(Mode::FewestHops, 0, 3, LLONG_MIN, 15);
+    CHECK(f.valid(hops, 0, 3, LLONG_MIN, 15));
+    CHECK(hops.hops() == 2);
+
+    Journey early = paths.find(Mode::EarliestArrival, 0, 3, 3, LLONG_MAX);
+    CHECK(f.valid(early, 0, 3, 3, LLONG_MAX));
+    CHECK(early.arrival() == 9);
+
+    for (Mode m : kModes) CHECK(!paths.find(m, 0, 3, 11, 19).found());
+}
+
+TEST(noTimeTravel) {
+    Fixture f;
+    auto g = f.store.freeze();
+    TemporalPaths paths(*g);
+    for (Mode m : kModes) {
+        CHECK(!paths.find(m, 5, 7).found());
+        CHECK(f.valid(paths.find(m, 7, 5), 7, 5, LLONG_MIN, LLONG_MAX));
+        CHECK(f.valid(paths.find(m, 8, 10), 8, 10, LLONG_MIN, LLONG_MAX));
+        CHECK(!paths.find(m, 0, 8).found());
+
+        Journey self = paths.find(m, 4, 4);
+        CHECK(self.found() && self.hops() == 0);
+    }
+}
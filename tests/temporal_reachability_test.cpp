@@ -0,0 +1,77 @@
+#include "tests/Check.h"
+#include "core/GraphStore.h"
+#include "analytics/TemporalPaths.h"
+#include "analytics/TemporalReachability.h"
+#include <random>
+#include <vector>
+#include <string>
+#include <climits>
+
+using namespace graph;
+
+namespace {
+
+// More than 64 nodes so the sources span several frontier words. Timestamps are
+// drawn from a narrow range to get plenty of same-instant chains, and self-loops
+// and repeated pairs are left in.
+struct Fixture {
+    static constexpr uint64_t n = 90;
+    GraphStore store;
+
+    explicit Fixture(unsigned seed) {
+        std::vector<std::string> labels(n, "n");
+        store.addNodes(labels);
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint64_t> node(0, n - 1);
+        std::uniform_int_distribution<long long> ts(0, 40);
+        for (int i = 0; i < 160; ++i) store.addEdge(node(rng), node(rng), ts(rng));
+    }
+};
+
+// What TemporalPaths says the earliest arrival is, in TemporalReachability's terms.
+long long expected(const TemporalPaths& paths, uint64_t s, uint64_t t, long long from, long long until) {
+    if (s >= Fixture::n || t >= Fixture::n) return TemporalReachability::kUnreachable;
+    if (s == t) return from;
+    Journey j = paths.find(TemporalPaths::Mode::EarliestArrival, s, t, from, until);
+    return j.found() ? j.arrival() : TemporalReachability::kUnreachable;
+}
+
+}
+
+TEST(manyToManyMatchesEarliestArrival) {
+    const long long windows[][2] = { { LLONG_MIN, LLONG_MAX }, { 10, LLONG_MAX }, { 5, 25 } };
+    for (unsigned seed : { 1u, 2u, 3u }) {
+        Fixture f(seed);
+        auto g = f.store.freeze();
+        TemporalPaths paths(*g);
+        TemporalReachability reach(*g);
+
+        std::vector<uint64_t> sources, targets;
+        for (uint64_t v = 0; v < Fixture::n; ++v) sources.push_back(v);
+        sources.push_back(7);                       // repeated source
+        sources.push_back(Fixture::n + 5);          // unknown source
+        for (uint64_t v = 0; v < Fixture::n; v += 3) targets.push_back(v);
+        targets.push_back(6);                       // repeated target
+        targets.push_back(Fixture::n + 9);          // unknown target
+
+        for (auto const& w : windows) {
+            auto rows = reach.manyToMany(sources, targets, w[0], w[1]);
+            CHECK(rows.size() == sources.size());
+            for (size_t i = 0; i < sources.size(); ++i)
+                for (size_t k = 0; k < targets.size(); ++k)
+                    CHECK(rows[i][k] == expected(paths, sources[i], targets[k], w[0], w[1]));
+        }
+    }
+}
+
+TEST(oneToManyIsARow) {
+    Fixture f(4);
+    auto g = f.store.freeze();
+    TemporalReachability reach(*g);
+    std::vector<uint64_t> sources, targets;
+    for (uint64_t v = 0; v < Fixture::n; ++v) { sources.push_back(v); targets.push_back(v); }
+    auto rows = reach.manyToMany(sources, targets, 3, 30);
+    for (uint64_t s = 0; s < Fixture::n; s += 11)
+        CHECK(reach.oneToMany(s, targets, 3, 30) == rows[s]);
+    CHECK(reach.oneToMany(0, {}).empty());
+}